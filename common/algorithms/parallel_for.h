@@ -65,6 +65,7 @@ namespace embree
 
 #elif defined(TASKING_TBB)
     tbb::parallel_for(tbb::blocked_range<Index>(first,last,minStepSize),[&](const tbb::blocked_range<Index>& r) { 
+        TraceScope trace("task");
         func(range<Index>(r.begin(),r.end()));
       });
     if (tbb::task::self().is_cancelled())
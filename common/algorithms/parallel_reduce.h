@@ -67,7 +67,7 @@ namespace embree
 
 #elif defined(TASKING_TBB)
     const Value v = tbb::parallel_reduce(tbb::blocked_range<Index>(first,last,minStepSize),identity,
-      [&](const tbb::blocked_range<Index>& r, const Value& start) { return reduction(start,func(range<Index>(r.begin(),r.end()))); },
+      [&](const tbb::blocked_range<Index>& r, const Value& start) { TraceScope trace("task"); return reduction(start,func(range<Index>(r.begin(),r.end()))); },
       reduction);
     if (tbb::task::self().is_cancelled())
       throw std::runtime_error("task cancelled");
@@ -70,6 +70,24 @@ namespace embree
   {
   }
 
+  void* os_map_file(const char* filename, size_t bytes)
+  {
+    HANDLE file = CreateFileA(filename,GENERIC_READ|GENERIC_WRITE,0,nullptr,CREATE_ALWAYS,FILE_ATTRIBUTE_TEMPORARY|FILE_FLAG_DELETE_ON_CLOSE,nullptr);
+    if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("cannot create file "+std::string(filename));
+    HANDLE map = CreateFileMappingA(file,nullptr,PAGE_READWRITE,DWORD(uint64_t(bytes) >> 32),DWORD(bytes),nullptr);
+    CloseHandle(file);
+    if (map == nullptr) throw std::runtime_error("cannot map file "+std::string(filename));
+    void* ptr = MapViewOfFile(map,FILE_MAP_ALL_ACCESS,0,0,bytes);
+    CloseHandle(map);
+    if (ptr == nullptr) throw std::runtime_error("cannot map file "+std::string(filename));
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes) 
+  {
+    if (bytes == 0) return;
+    UnmapViewOfFile(ptr);
+  }
 }
 #endif
 
@@ -80,6 +98,8 @@ namespace embree
 #if defined(__UNIX__)
 
 #include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
@@ -203,6 +223,28 @@ namespace embree
     if (munmap(ptr,bytes) == -1)
       /*throw std::bad_alloc()*/ return;  // we on purpose do not throw an exception when an error occurs, to avoid throwing an exception during error handling
   }
+
+  void* os_map_file(const char* filename, size_t bytes)
+  {
+    int fd = open(filename,O_RDWR|O_CREAT|O_TRUNC,0600);
+    if (fd == -1) throw std::runtime_error("cannot create file "+std::string(filename));
+    if (ftruncate(fd,bytes) == -1) {
+      close(fd); unlink(filename);
+      throw std::runtime_error("cannot resize file "+std::string(filename));
+    }
+    void* ptr = mmap(0,bytes,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+    
+    /* the mapping keeps the file alive, thus we can already remove it */
+    close(fd); unlink(filename);
+    if (ptr == MAP_FAILED) throw std::runtime_error("cannot map file "+std::string(filename));
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes) 
+  {
+    if (bytes == 0) return;
+    munmap(ptr,bytes);
+  }
 }
 
 #endif
@@ -84,6 +84,10 @@ namespace embree
   void  os_free   (void* ptr, size_t bytes);
   void  os_advise (void* ptr, size_t bytes);
 
+  /*! maps a temporary file of the specified size into memory, the file gets deleted when unmapped */
+  void* os_map_file  (const char* filename, size_t bytes);
+  void  os_unmap_file(void* ptr, size_t bytes);
+
   /*! allocator that performs OS allocations */
   template<typename T>
     struct os_allocator
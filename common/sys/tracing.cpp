@@ -0,0 +1,135 @@
+// ======================================================================== //
+// Copyright 2009-2017 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "tracing.h"
+#include "mutex.h"
+
+#include <vector>
+#include <set>
+#include <algorithm>
+
+namespace embree
+{
+  struct TraceEvent
+  {
+    const char* name;
+    double time;
+    char phase;        //!< 'B' for begin and 'E' for end of event
+  };
+
+  /*! ring buffer of the events of one thread, only the owning thread adds events */
+  struct TraceBuffer
+  {
+    static const size_t MAX_EVENTS = 64*1024;
+
+    TraceBuffer (size_t tid)
+      : tid(tid), numEvents(0), numWritten(0) {}
+
+    __forceinline void add(const char* name, char phase)
+    {
+      const size_t i = numEvents.load(std::memory_order_relaxed);
+      TraceEvent& event = events[i%MAX_EVENTS];
+      event.name = name;
+      event.time = getSeconds();
+      event.phase = phase;
+      numEvents.store(i+1,std::memory_order_release);
+    }
+
+  public:
+    size_t tid;                       //!< thread ID in trace
+    std::atomic<size_t> numEvents;    //!< number of events added so far
+    size_t numWritten;                //!< number of events already written
+    TraceEvent events[MAX_EVENTS];
+  };
+
+  std::atomic<bool> Tracing::g_enabled(false);
+
+  static MutexSys g_trace_mutex;
+  static std::vector<std::unique_ptr<TraceBuffer>> g_trace_buffers;
+  static std::set<std::string> g_trace_names;
+  static __thread TraceBuffer* g_trace_buffer = nullptr;
+
+  static __forceinline TraceBuffer* threadTraceBuffer()
+  {
+    if (unlikely(g_trace_buffer == nullptr))
+    {
+      Lock<MutexSys> lock(g_trace_mutex);
+      g_trace_buffers.push_back(make_unique(new TraceBuffer(g_trace_buffers.size())));
+      g_trace_buffer = g_trace_buffers.back().get();
+    }
+    return g_trace_buffer;
+  }
+
+  void Tracing::enable(bool enabled) {
+    g_enabled = enabled;
+  }
+
+  void Tracing::begin(const char* name) {
+    threadTraceBuffer()->add(name,'B');
+  }
+
+  void Tracing::end() {
+    threadTraceBuffer()->add(nullptr,'E');
+  }
+
+  const char* Tracing::intern(const std::string& name)
+  {
+    Lock<MutexSys> lock(g_trace_mutex);
+    return g_trace_names.insert(name).first->c_str();
+  }
+
+  bool Tracing::write(const std::string& fileName)
+  {
+    Lock<MutexSys> lock(g_trace_mutex);
+
+    /* events older than MAX_EVENTS got overwritten */
+    std::vector<std::pair<size_t,size_t>> ranges;
+    double t0 = 0.0;
+    for (size_t b=0; b<g_trace_buffers.size(); b++)
+    {
+      TraceBuffer* buffer = g_trace_buffers[b].get();
+      const size_t end = buffer->numEvents.load(std::memory_order_acquire);
+      const size_t begin = std::max(buffer->numWritten, end > TraceBuffer::MAX_EVENTS ? end-TraceBuffer::MAX_EVENTS : size_t(0));
+      ranges.push_back(std::make_pair(begin,end));
+      if (begin < end) {
+        const double t = buffer->events[begin%TraceBuffer::MAX_EVENTS].time;
+        if (t0 == 0.0 || t < t0) t0 = t;
+      }
+    }
+
+    std::ofstream file(fileName.c_str());
+    if (!file) return false;
+    file << "{\"traceEvents\":[" << std::endl;
+    file << std::fixed << std::setprecision(3);
+    bool first = true;
+    for (size_t b=0; b<g_trace_buffers.size(); b++)
+    {
+      TraceBuffer* buffer = g_trace_buffers[b].get();
+      for (size_t i=ranges[b].first; i<ranges[b].second; i++)
+      {
+        const TraceEvent& event = buffer->events[i%TraceBuffer::MAX_EVENTS];
+        if (!first) file << "," << std::endl;
+        file << "{";
+        if (event.name) file << "\"name\":\"" << event.name << "\",";
+        file << "\"ph\":\"" << event.phase << "\",\"ts\":" << 1E6*(event.time-t0) << ",\"pid\":0,\"tid\":" << buffer->tid << "}";
+        first = false;
+      }
+      buffer->numWritten = ranges[b].second;
+    }
+    file << std::endl << "]}" << std::endl;
+    return true;
+  }
+}
@@ -0,0 +1,80 @@
+// ======================================================================== //
+// Copyright 2009-2017 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "platform.h"
+#include "sysinfo.h"
+
+#include <atomic>
+
+namespace embree
+{
+  /*! Records begin and end events of tasks and build phases into a
+   *  ring buffer per thread. The recorded events can get written in
+   *  the Chrome trace event format, which can be viewed with
+   *  chrome://tracing or Perfetto. Recording is disabled by default
+   *  and then costs a single branch per event. */
+  struct Tracing
+  {
+    /*! enables or disables recording of events */
+    static void enable(bool enabled);
+
+    /*! returns true if recording is enabled */
+    static __forceinline bool enabled() {
+      return g_enabled.load(std::memory_order_relaxed);
+    }
+
+    /*! records the begin of an event, name has to stay valid until the trace got written */
+    static void begin(const char* name);
+
+    /*! records the end of the last event begun by this thread */
+    static void end();
+
+    /*! returns a copy of the string that stays valid until the program terminates */
+    static const char* intern(const std::string& name);
+
+    /*! writes all events recorded since the last write to a file in Chrome trace format, returns false if the file cannot get written */
+    static bool write(const std::string& fileName);
+
+  private:
+    static std::atomic<bool> g_enabled;
+  };
+
+  /*! records an event for the lifetime of the object, no event is recorded if name is null */
+  struct TraceScope
+  {
+    __forceinline TraceScope (const char* name)
+      : active(name != nullptr && Tracing::enabled())
+    {
+      if (unlikely(active)) Tracing::begin(name);
+    }
+
+    __forceinline ~TraceScope () {
+      end();
+    }
+
+    /*! ends the event before the object gets destroyed */
+    __forceinline void end()
+    {
+      if (unlikely(active)) Tracing::end();
+      active = false;
+    }
+
+  private:
+    bool active;
+  };
+}
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "../sys/tracing.h"
+
 #if defined(TASKING_INTERNAL)
 #  include "taskschedulerinternal.h"
 #elif defined(TASKING_TBB)
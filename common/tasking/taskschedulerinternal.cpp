@@ -17,7 +17,9 @@
 #include "taskschedulerinternal.h"
 #include "../math/math.h"
 #include "../sys/sysinfo.h"
+#include "../sys/tracing.h"
 #include <algorithm>
+#include <limits>
 
 namespace embree
 {
@@ -25,28 +27,27 @@ namespace embree
   __thread TaskScheduler* TaskScheduler::g_instance = nullptr;
   __thread TaskScheduler::Thread* TaskScheduler::thread_local_thread = nullptr;
   TaskScheduler::ThreadPool* TaskScheduler::threadPool = nullptr;
+  size_t TaskScheduler::g_idleSpinRounds = 32;
 
   template<typename Predicate, typename Body>
-  __forceinline void TaskScheduler::steal_loop(Thread& thread, const Predicate& pred, const Body& body)
+  __forceinline bool TaskScheduler::steal_loop(Thread& thread, const Predicate& pred, const Body& body, size_t spinRounds)
   {
-    while (true)
+    /*! some rounds that yield */
+    for (size_t i=0; i<spinRounds; i++)
     {
-      /*! some rounds that yield */
-      for (size_t i=0; i<32; i++)
+      /*! some spinning rounds */
+      const size_t threadCount = thread.threadCount();
+      for (size_t j=0; j<1024; j+=threadCount)
       {
-        /*! some spinning rounds */
-        const size_t threadCount = thread.threadCount();
-        for (size_t j=0; j<1024; j+=threadCount)
-        {
-          if (!pred()) return;
-          if (thread.scheduler->steal_from_other_threads(thread)) {
-            i=j=0;
-            body();
-          }
+        if (!pred()) return true;
+        if (thread.scheduler->steal_from_other_threads(thread)) {
+          i=j=0;
+          body();
         }
-        yield();
       }
+      yield();
     }
+    return false;
   }
 
   /*! run this task */
@@ -58,8 +59,11 @@ namespace embree
       Task* prevTask = thread.task; 
       thread.task = this;
       try {
-        if (thread.scheduler->cancellingException == nullptr)
+        if (thread.scheduler->cancellingException == nullptr) {
+          if (thread.scheduler->cancelled) throw Cancelled();
+          TraceScope trace("task");
           closure->execute();
+        }
       } catch (...) {
         if (thread.scheduler->cancellingException == nullptr)
           thread.scheduler->cancellingException = std::current_exception();
@@ -135,7 +139,7 @@ namespace embree
   }
 
   TaskScheduler::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+    : maxPriority(std::numeric_limits<int>::min()), numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
 
   __dllexport void TaskScheduler::ThreadPool::startThreads()
   {
@@ -191,7 +195,18 @@ namespace embree
   __dllexport void TaskScheduler::ThreadPool::add(const Ref<TaskScheduler>& scheduler)
   {
     mutex.lock();
-    schedulers.push_back(scheduler);
+
+    /* keep schedulers sorted by priority, schedulers of same priority in FIFO order */
+    std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin();
+    while (it != schedulers.end() && (*it)->priority >= scheduler->priority) it++;
+    schedulers.insert(it,scheduler);
+    maxPriority = schedulers.front()->priority;
+
+    /* parked threads of lower priority schedulers should come to help */
+    for (it = schedulers.begin(); it != schedulers.end(); it++)
+      if ((*it)->priority < scheduler->priority && (*it)->numParkedThreads > 0) 
+        (*it)->wakeParkedThreads();
+    
     mutex.unlock();
     condition.notify_all();
   }
@@ -202,11 +217,26 @@ namespace embree
     for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++) {
       if (scheduler == *it) {
         schedulers.erase(it);
+        maxPriority = schedulers.empty() ? std::numeric_limits<int>::min() : schedulers.front()->priority;
         return;
       }
     }
   }
 
+  bool TaskScheduler::ThreadPool::join_higher_priority(int priority)
+  {
+    Ref<TaskScheduler> scheduler = NULL;
+    ssize_t threadIndex = -1;
+    {
+      Lock<MutexSys> lock(mutex);
+      if (schedulers.empty() || schedulers.front()->priority <= priority) return false;
+      scheduler = schedulers.front();
+      threadIndex = scheduler->allocThreadIndex();
+    }
+    scheduler->thread_loop(threadIndex);
+    return true;
+  }
+
   void TaskScheduler::ThreadPool::thread_loop(size_t globalThreadIndex)
   {
     while (globalThreadIndex < numThreadsRunning)
@@ -225,7 +255,7 @@ namespace embree
   }
   
   TaskScheduler::TaskScheduler()
-    : threadCounter(0), anyTasksRunning(0), hasRootTask(false) 
+    : threadCounter(0), anyTasksRunning(0), hasRootTask(false), cancelled(false), priority(0), numParkedThreads(0), parkEpoch(0)
   {
     threadLocal.resize(2*getNumberOfLogicalThreads()); // FIXME: this has to be 2x as in the compatibility join mode with rtcCommit the worker threads also join. When disallowing rtcCommit to join a build we can remove the 2x.
     for (size_t i=0; i<threadLocal.size(); i++)
@@ -267,6 +297,10 @@ namespace embree
     delete threadPool; threadPool = nullptr;
   }
 
+  void TaskScheduler::setIdleSpinRounds(size_t rounds) {
+    g_idleSpinRounds = rounds;
+  }
+
   __dllexport ssize_t TaskScheduler::allocThreadIndex()
   {
     size_t threadIndex = threadCounter++;
@@ -310,7 +344,7 @@ namespace embree
     Thread* thread = TaskScheduler::thread();
     if (thread == nullptr) return true;
     while (thread->tasks.execute_local(*thread,thread->task)) {};
-    return thread->scheduler->cancellingException == nullptr;
+    return thread->scheduler->cancellingException == nullptr && !thread->scheduler->cancelled;
   }
 
   std::exception_ptr TaskScheduler::thread_loop(size_t threadIndex)
@@ -321,20 +355,43 @@ namespace embree
     threadLocal[threadIndex].store(&thread);
     Thread* oldThread = swapThread(&thread);
 
-    /* main thread loop */
+    /* main thread loop, parks the thread when no task got stolen for some time */
+    const double t0 = getSeconds();
     while (anyTasksRunning)
     {
-      steal_loop(thread,
-                 [&] () { return anyTasksRunning > 0; },
+      /* the local task queue is empty here, thus we can help higher priority schedulers */
+      if (hasHigherPriorityScheduler()) {
+        const double t1 = getSeconds();
+        threadPool->join_higher_priority(priority);
+        thread.workTime += getSeconds()-t1;
+        continue;
+      }
+
+      const bool done = steal_loop(thread,
+                 [&] () { return anyTasksRunning > 0 && !hasHigherPriorityScheduler(); },
                  [&] () { 
+                   const double t1 = getSeconds();
                    anyTasksRunning++;
                    while (thread.tasks.execute_local(thread,nullptr));
-                   anyTasksRunning--;
-                 });
+                   if (--anyTasksRunning == 0 && numParkedThreads > 0) wakeParkedThreads();
+                   thread.workTime += getSeconds()-t1;
+                 },
+                 g_idleSpinRounds);
+      if (!done) park(thread);
     }
+    const double t2 = getSeconds();
     threadLocal[threadIndex].store(nullptr);
     swapThread(oldThread);
 
+    /* accumulate idle statistics */
+    {
+      Lock<MutexSys> lock(mutex);
+      idleStats.workTime += thread.workTime;
+      idleStats.parkTime += thread.parkTime;
+      idleStats.spinTime += (t2-t0)-thread.workTime-thread.parkTime;
+      idleStats.numParks += thread.numParks;
+    }
+
     /* remember exception to throw */
     std::exception_ptr except = nullptr;
     if (cancellingException != nullptr) except = cancellingException;
@@ -359,6 +416,52 @@ namespace embree
     return except;
   }
 
+  bool TaskScheduler::hasStealableTasks()
+  {
+    const size_t threadCount = this->threadCounter;
+    for (size_t i=0; i<threadCount; i++)
+    {
+      Thread* othread = threadLocal[i].load();
+      if (othread && othread->tasks.left < othread->tasks.right)
+        return true;
+    }
+    return false;
+  }
+
+  void TaskScheduler::park(Thread& thread)
+  {
+    const double t0 = getSeconds();
+    {
+      Lock<MutexSys> lock(mutex);
+      const size_t epoch = parkEpoch;
+
+      /* spawning threads check numParkedThreads after pushing a task, thus
+       * we either see their task here or they will wake us up */
+      numParkedThreads++;
+      idleCondition.wait(mutex, [&] () { 
+          return parkEpoch != epoch || anyTasksRunning == 0 || hasStealableTasks() || hasHigherPriorityScheduler();
+        });
+      numParkedThreads--;
+    }
+    thread.parkTime += getSeconds()-t0;
+    thread.numParks++;
+  }
+
+  __dllexport void TaskScheduler::wakeParkedThreads()
+  {
+    {
+      Lock<MutexSys> lock(mutex);
+      parkEpoch++;
+    }
+    idleCondition.notify_all();
+  }
+
+  __dllexport TaskScheduler::IdleStatistics TaskScheduler::idleStatistics()
+  {
+    Lock<MutexSys> lock(mutex);
+    return idleStats;
+  }
+
   bool TaskScheduler::steal_from_other_threads(Thread& thread)
   {
     const size_t threadIndex = thread.threadIndex;
@@ -39,6 +39,11 @@ namespace embree
     static const size_t CLOSURE_STACK_SIZE = 256*1024;    //!< stack for task closures
 
     struct Thread;
+
+    /*! exception thrown into the tasks of a cancelled task scheduler */
+    struct Cancelled : public std::exception {
+      const char* what() const throw() { return "task scheduler got cancelled"; }
+    };
     
     /*! virtual interface for all tasks */
     struct TaskFunction {
@@ -168,7 +173,7 @@ namespace embree
       ALIGNED_STRUCT;
 
       Thread (size_t threadIndex, const Ref<TaskScheduler>& scheduler)
-      : threadIndex(threadIndex), task(nullptr), scheduler(scheduler) {}
+      : threadIndex(threadIndex), task(nullptr), scheduler(scheduler), workTime(0.0), parkTime(0.0), numParks(0) {}
 
       __forceinline size_t threadCount() {
         return scheduler->threadCounter;
@@ -178,6 +183,21 @@ namespace embree
       TaskQueue tasks;                 //!< local task queue
       Task* task;                      //!< current active task
       Ref<TaskScheduler> scheduler;     //!< pointer to task scheduler
+      double workTime;                 //!< time spent executing tasks in the thread loop
+      double parkTime;                 //!< time spent parked in the thread loop
+      size_t numParks;                 //!< number of times this thread got parked
+    };
+
+    /*! time the worker threads of a task scheduler spent working, spinning, and parked */
+    struct IdleStatistics
+    {
+      IdleStatistics ()
+      : workTime(0.0), spinTime(0.0), parkTime(0.0), numParks(0) {}
+
+      double workTime;
+      double spinTime;
+      double parkTime;
+      size_t numParks;
     };
 
     /*! pool of worker threads */
@@ -203,7 +223,13 @@ namespace embree
 
       /*! main loop for all threads */
       void thread_loop(size_t threadIndex);
-      
+
+      /*! lets the calling thread help the scheduler of highest priority if it has a higher priority than the specified one */
+      bool join_higher_priority(int priority);
+
+    public:
+      std::atomic<int> maxPriority;      //!< highest priority of all added schedulers
+
     private:
       std::atomic<size_t> numThreads;
       std::atomic<size_t> numThreadsRunning;
@@ -225,6 +251,18 @@ namespace embree
 
     /*! destroys the task scheduler again */
     static void destroy();
+
+    /*! sets the number of spin rounds an idle worker thread performs before it parks */
+    static void setIdleSpinRounds(size_t rounds);
+
+    /*! sets the priority of this scheduler, worker threads help schedulers of higher priority first */
+    void setPriority(int p) { priority = p; }
+
+    /*! cancels all tasks of this scheduler, tasks not started yet get skipped and spawning new tasks throws */
+    void cancel() { cancelled = true; }
+
+    /*! checks if this scheduler got cancelled */
+    bool isCancelled() const { return cancelled; }
     
     /*! lets new worker threads join the tasking system */
     void join();
@@ -242,8 +280,26 @@ namespace embree
     /*! steals a task from a different thread */
     bool steal_from_other_threads(Thread& thread);
 
+    /*! steals and executes tasks as long as pred holds, returns false if no task got stolen for spinRounds rounds */
     template<typename Predicate, typename Body>
-      static void steal_loop(Thread& thread, const Predicate& pred, const Body& body);
+      static bool steal_loop(Thread& thread, const Predicate& pred, const Body& body, size_t spinRounds = size_t(-1));
+
+    /*! blocks an idle worker thread until new tasks got spawned or all tasks have finished */
+    void park(Thread& thread);
+
+    /*! returns true if some thread has tasks that can get stolen */
+    bool hasStealableTasks();
+
+    /*! returns true if the thread pool has a scheduler of higher priority */
+    bool hasHigherPriorityScheduler() const {
+      return threadPool && threadPool->maxPriority > priority;
+    }
+
+    /*! wakes up all parked worker threads */
+    __dllexport void wakeParkedThreads();
+
+    /*! returns the idle statistics of all worker threads that left this scheduler */
+    __dllexport IdleStatistics idleStatistics();
 
     /* spawn a new task at the top of the threads task stack */
     template<typename Closure>
@@ -268,7 +324,7 @@ namespace embree
       if (useThreadPool) addScheduler(this);
 
       while (thread.tasks.execute_local(thread,nullptr));
-      anyTasksRunning--;
+      if (--anyTasksRunning == 0 && numParkedThreads > 0) wakeParkedThreads();
       if (useThreadPool) removeScheduler(this);
       
       threadLocal[threadIndex] = nullptr;
@@ -293,8 +349,16 @@ namespace embree
     static __forceinline void spawn(size_t size, const Closure& closure) 
     {
       Thread* thread = TaskScheduler::thread();
-      if (likely(thread != nullptr)) thread->tasks.push_right(*thread,size,closure);
-      else                           instance()->spawn_root(closure,size);
+      if (likely(thread != nullptr)) 
+      {
+        if (unlikely(thread->scheduler->cancelled))
+          throw Cancelled();
+        thread->tasks.push_right(*thread,size,closure);
+        if (unlikely(thread->scheduler->numParkedThreads > 0))
+          thread->scheduler->wakeParkedThreads();
+      }
+      else
+        instance()->spawn_root(closure,size);
     }
 
     /* spawn a new task at the top of the threads task stack */
@@ -354,11 +418,20 @@ namespace embree
     std::atomic<size_t> anyTasksRunning;
     std::atomic<bool> hasRootTask;
     std::exception_ptr cancellingException;
+    std::atomic<bool> cancelled;       //!< set when all tasks of this scheduler should get skipped
+    int priority;                      //!< priority of this scheduler in the thread pool
     MutexSys mutex;
     ConditionSys condition;
 
+  private:
+    __aligned(64) std::atomic<size_t> numParkedThreads; //!< number of worker threads parked in idleCondition
+    size_t parkEpoch;                  //!< incremented under mutex on each wakeup
+    ConditionSys idleCondition;        //!< parked worker threads wait here
+    IdleStatistics idleStats;          //!< accumulated idle statistics, protected by mutex
+
   private:
     static size_t g_numThreads;
+    static size_t g_idleSpinRounds;
     static __thread TaskScheduler* g_instance;
     static __thread Thread* thread_local_thread;
     static ThreadPool* threadPool;
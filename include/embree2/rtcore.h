@@ -172,6 +172,11 @@ enum RTCParameter {
 
   RTC_CONFIG_COMMIT_JOIN = 23,               //!< checks if rtcCommitJoin can be used to join build operation (not supported when compiled with some older TBB versions)
   RTC_CONFIG_COMMIT_THREAD = 24,             //!< checks if rtcCommitThread is available (not supported when compiled with some older TBB versions)
+
+  RTC_SOFTWARE_CACHE_HITS = 25,              //!< returns number of software cache lookups served from the cache (read only)
+  RTC_SOFTWARE_CACHE_MISSES = 26,            //!< returns number of software cache lookups that required tessellation (read only)
+  RTC_SOFTWARE_CACHE_FLUSHES = 27,           //!< returns number of software cache segments that got recycled (read only)
+  RTC_TRACE_WRITE = 28,                      //!< writes the build events recorded since the last write to the configured trace_file (write only)
 };
 
 /*! \brief Configures some parameters. 
@@ -198,7 +203,7 @@ enum RTCError {
   RTC_INVALID_OPERATION = 3, //!< The operation is not allowed for the specified object.
   RTC_OUT_OF_MEMORY = 4,     //!< There is not enough memory left to execute the command.
   RTC_UNSUPPORTED_CPU = 5,   //!< The CPU is not supported as it does not support SSE2.
-  RTC_CANCELLED = 6,         //!< The user has cancelled the operation through the RTC_PROGRESS_MONITOR_FUNCTION callback
+  RTC_CANCELLED = 6,         //!< The user has cancelled the operation through the RTC_PROGRESS_MONITOR_FUNCTION callback or rtcCancelCommit
 };
 
 /*! \brief Returns the value of the per-thread error flag. 
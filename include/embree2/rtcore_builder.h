@@ -109,6 +109,41 @@ RTCORE_API void* rtcBuildBVH(RTCBVH bvh,                                     //!
                              void* userPtr                                   //!< user pointer passed to callback functions
   ); 
 
+/*! Node of a BVH in compact output format. The children of an inner
+ *  node are stored consecutively in the node array, the root node is
+ *  stored at index 0. */
+struct RTCORE_ALIGN(32) RTCCompactNode
+{
+  float lower_x, lower_y, lower_z;  //!< lower bounds in x/y/z
+  unsigned offset;                  //!< index of first child for inner nodes, index of first primitive for leaves
+  float upper_x, upper_y, upper_z;  //!< upper bounds in x/y/z
+  unsigned count;                   //!< number of children for inner nodes, number of primitives ORed with RTC_COMPACT_NODE_LEAF for leaves
+};
+
+/*! Flag marking leaf nodes in the count member of RTCCompactNode. */
+#define RTC_COMPACT_NODE_LEAF 0x80000000
+
+/*! builds the BVH directly into a compact node array without invoking
+ *  any node callbacks, the returned array is owned by the BVH and
+ *  valid until the next build */
+RTCORE_API const RTCCompactNode* rtcBuildBVHCompact(RTCBVH bvh,                        //!< BVH to build
+                                                    const RTCBuildSettings& settings,  //!< settings for BVH builder
+                                                    RTCBuildPrimitive* primitives,     //!< list of input primitives
+                                                    size_t numPrimitives,              //!< number of input primitives
+                                                    RTCSplitPrimitiveFunc splitPrimitive, //!< splits a primitive
+                                                    RTCBuildProgressFunc buildProgress,   //!< used to report build progress
+                                                    void* userPtr,                     //!< user pointer passed to callback functions
+                                                    size_t* numNodes                   //!< returns the number of nodes in the array
+  );
+
+/*! refits the BVH of the last build to new bounds of the primitives,
+ *  the primitive array has to be in the order left by the build */
+RTCORE_API void rtcRefitBVH(RTCBVH bvh,                                     //!< BVH to refit
+                            const RTCBuildPrimitive* primitives,            //!< primitives with updated bounds
+                            RTCSetNodeBoundsFunc setNodeBounds,             //!< sets bounds of all children, may be NULL
+                            void* userPtr                                   //!< user pointer passed to callback functions
+  );
+
 /*! Allocates memory using the thread local allocator. Use this function to allocate nodes in the callback functions. */
 RTCORE_API void* rtcThreadLocalAlloc(RTCThreadLocalAllocator allocator, size_t bytes, size_t align);
 
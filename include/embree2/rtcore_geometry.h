@@ -156,6 +156,23 @@ typedef void (*RTCDisplacementFunc2)(void* ptr,           /*!< pointer to user d
                                      float* pz,           /*!< z coordinates of points to displace (source and target) */
                                      size_t N             /*!< number of points to displace */ );
 
+/*! Batched displacement mapping function. Displaces the points of
+    many patches of a subdivision mesh at once, thus primitive ID and
+    time step are passed for each point. */
+typedef void (*RTCDisplacementFuncN)(void* ptr,              /*!< pointer to user data of geometry */
+                                     unsigned geomID,        /*!< ID of geometry to displace */
+                                     const unsigned* primIDs, /*!< IDs of primitives of geometry to displace */
+                                     const unsigned* times,  /*!< time steps to calculate displacement for */
+                                     const float* u,         /*!< u coordinates (source) */
+                                     const float* v,         /*!< v coordinates (source) */
+                                     const float* nx,        /*!< x coordinates of normalized normal at point to displace (source) */
+                                     const float* ny,        /*!< y coordinates of normalized normal at point to displace (source) */
+                                     const float* nz,        /*!< z coordinates of normalized normal at point to displace (source) */
+                                     float* px,              /*!< x coordinates of points to displace (source and target) */
+                                     float* py,              /*!< y coordinates of points to displace (source and target) */
+                                     float* pz,              /*!< z coordinates of points to displace (source and target) */
+                                     size_t N                /*!< number of points to displace */ );
+
 /*! \brief Creates a new scene instance. 
 
   WARNING: This function is deprecated, use rtcNewInstance2 instead.
@@ -492,11 +509,43 @@ RTCORE_API unsigned rtcNewLineSegments (RTCScene scene,                    //!<
                                         size_t numTimeSteps = 1            //!< number of motion blur time steps
   );
 
+/*! \brief Creates a new round line segment geometry. The buffers and
+  their layout are identical to line segments created with
+  rtcNewLineSegments, but each segment is intersected as a true cone
+  between its end points, closed by spheres at both end points. Round
+  line segments can be viewed from close distance without artefacts,
+  and consecutive segments join seamlessly. */
+RTCORE_API unsigned rtcNewRoundLineSegments (RTCScene scene,               //!< the scene the line segments belong to
+                                             RTCGeometryFlags flags,       //!< geometry flags
+                                             size_t numSegments,           //!< number of line segments
+                                             size_t numVertices,           //!< number of vertices
+                                             size_t numTimeSteps = 1       //!< number of motion blur time steps
+  );
+
 /*! Sets a uniform tessellation rate for subdiv meshes and hair
  *  geometry. For subdivision meshes the RTC_LEVEL_BUFFER can also be used
  *  optionally to set a different tessellation rate per edge.*/
 RTCORE_API void rtcSetTessellationRate (RTCScene scene, unsigned geomID, float tessellationRate);
 
+/*! \brief Camera parameters for view dependent tessellation of subdivision meshes. */
+struct RTCTessellationView
+{
+  float camera_x, camera_y, camera_z;  //!< position of the camera
+  float dir_x, dir_y, dir_z;           //!< viewing direction of the camera, used for culling
+  float fovy;                          //!< vertical field of view in degrees
+  float aspect;                        //!< aspect ratio (width/height) of the image, used for culling
+  unsigned height;                     //!< height of the image in pixels
+  float pixelsPerEdge;                 //!< desired projected length of tessellated edges in pixels
+  float culledLevel;                   //!< tessellation level of edges outside the view frustum, negative values disable culling
+};
+
+/*! Enables view dependent tessellation for a subdivision mesh. At
+ *  each commit the tessellation level of each edge is calculated from
+ *  its projected length for the specified camera. Both half edges of
+ *  an edge get assigned the same level, thus the tessellation is crack
+ *  free. Passing NULL disables view dependent tessellation again. */
+RTCORE_API void rtcSetTessellationView (RTCScene scene, unsigned geomID, const RTCTessellationView* view);
+
 /*! \brief Sets 32 bit ray mask. */
 RTCORE_API void rtcSetMask (RTCScene scene, unsigned geomID, int mask);
 
@@ -587,6 +636,9 @@ RTCORE_API void rtcSetDisplacementFunction (RTCScene scene, unsigned geomID, RTC
 /*! \brief Sets the displacement function. */
 RTCORE_API void rtcSetDisplacementFunction2 (RTCScene scene, unsigned geomID, RTCDisplacementFunc2 func, RTCBounds* bounds);
 
+/*! \brief Sets the batched displacement function. */
+RTCORE_API void rtcSetDisplacementFunctionN (RTCScene scene, unsigned geomID, RTCDisplacementFuncN func, RTCBounds* bounds);
+
 /*! \brief Sets the intersection filter function for single rays. */
 RTCORE_API void rtcSetIntersectionFilterFunction (RTCScene scene, unsigned geomID, RTCFilterFunc func);
 
@@ -112,6 +112,15 @@ RTCORE_API void rtcCommitJoin (RTCScene scene);
  *  coprocessor. */
 RTCORE_API void rtcCommitThread(RTCScene scene, unsigned int threadID, unsigned int numThreads);
 
+/*! Sets the priority of the commits of the scene. Worker threads help
+ *  commits of higher priority first. The default priority is 0. */
+RTCORE_API void rtcSetCommitPriority(RTCScene scene, int priority);
+
+/*! Cancels a commit of the scene that is in progress. The commit
+ *  returns with an RTC_CANCELLED error and the scene has to get
+ *  committed again before tracing rays. */
+RTCORE_API void rtcCancelCommit(RTCScene scene);
+
 /*! Returns AABB of the scene. rtcCommit has to get called
  *  previously to this function. */
 RTCORE_API void rtcGetBounds(RTCScene scene, RTCBounds& bounds_o);
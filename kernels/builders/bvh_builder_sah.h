@@ -198,8 +198,13 @@ namespace embree
           if (toplevel && current.size() <= singleThreadThreshold)
             progressMonitor(current.size());
 
+          /* trace sequentially built subtrees and the binning of large nodes */
+          TraceScope traceSubtree(toplevel && current.size() <= singleThreadThreshold ? "subtree" : nullptr);
+
           /*! find best split */
+          TraceScope traceBinning(current.size() > singleThreadThreshold ? "binning" : nullptr);
           auto split = heuristic.find(current.prims,logBlockSize);
+          traceBinning.end();
           
           /*! compute leaf and split cost */
           const float leafSAH  = intCost*current.prims.leafSAH(logBlockSize);
@@ -74,6 +74,19 @@ namespace embree
           return Vec3ia(floori((vfloat4(p)-ofs)*scale));
         }
 
+#if defined(__AVX__)
+        /*! calculates bin IDs of 8 centers at once, centers are given in SOA layout */
+        __forceinline void bin8(const vfloat8& px, const vfloat8& py, const vfloat8& pz, vint8& ix, vint8& iy, vint8& iz) const
+        {
+          ix = floori((px-vfloat8(ofs[0]))*vfloat8(scale[0]));
+          iy = floori((py-vfloat8(ofs[1]))*vfloat8(scale[1]));
+          iz = floori((pz-vfloat8(ofs[2]))*vfloat8(scale[2]));
+          assert(all(ix >= vint8(zero)) && all(ix < vint8(int(num))));
+          assert(all(iy >= vint8(zero)) && all(iy < vint8(int(num))));
+          assert(all(iz >= vint8(zero)) && all(iz < vint8(int(num))));
+        }
+#endif
+
         /*! faster but unsafe binning */
         template<typename PrimRef>
         __forceinline Vec3ia bin_unsafe(const PrimRef& p) const {
@@ -198,8 +211,35 @@ namespace embree
       __forceinline void bin (const PrimRef* prims, size_t N, const BinMapping<BINS>& mapping)
       {
 	if (unlikely(N == 0)) return;
-	size_t i; 
-	for (i=0; i<N-1; i+=2)
+	size_t i = 0;
+
+#if defined(__AVX__)
+        /*! map 8 primitives at once to bins */
+	for (; i+8<=N; i+=8)
+        {
+          BBox prim[8]; Vec3fa center[8];
+          for (size_t j=0; j<8; j++)
+            prims[i+j].binBoundsAndCenter(prim[j],center[j]);
+
+          vfloat8 cx,cy,cz;
+          transpose(vfloat4(center[0]),vfloat4(center[1]),vfloat4(center[2]),vfloat4(center[3]),
+                    vfloat4(center[4]),vfloat4(center[5]),vfloat4(center[6]),vfloat4(center[7]),
+                    cx,cy,cz);
+          vint8 bx,by,bz;
+          mapping.bin8(cx,cy,cz,bx,by,bz);
+
+          /*! increase bounds of bins for all 8 primitives */
+          for (size_t j=0; j<8; j++)
+          {
+            const unsigned int s = prims[i+j].size();
+            const int b0 = bx[j]; counts(b0,0)+=s; bounds(b0,0).extend(prim[j]);
+            const int b1 = by[j]; counts(b1,1)+=s; bounds(b1,1).extend(prim[j]);
+            const int b2 = bz[j]; counts(b2,2)+=s; bounds(b2,2).extend(prim[j]);
+          }
+        }
+#endif
+
+	for (; i+1<N; i+=2)
         {
           /*! map even and odd primitive to bin */
           BBox prim0; Vec3fa center0;
@@ -901,15 +941,37 @@ namespace embree
 #endif
   }
 
+  /*! bins in parallel using one cache aligned bin accumulator per task, only the used bins get merged at the end */
+  template<typename BinInfoT, typename BinMapping, typename PrimRef>
+  __noinline void bin_parallel_threadlocal(BinInfoT& binner, const PrimRef* prims, size_t begin, size_t end, size_t blockSize, const BinMapping& mapping)
+  {
+    const size_t maxTasks = 512;
+    const size_t threadCount = TaskScheduler::threadCount();
+    const size_t taskCount = min((end-begin+blockSize-1)/blockSize,threadCount,maxTasks);
+    if (taskCount <= 1) {
+      binner.bin(prims,begin,end,mapping);
+      return;
+    }
+
+    dynamic_large_stack_array(BinInfoT,binners,taskCount,8192);
+    parallel_for(taskCount, [&](const size_t taskIndex) {
+        const size_t k0 = begin+(taskIndex+0)*(end-begin)/taskCount;
+        const size_t k1 = begin+(taskIndex+1)*(end-begin)/taskCount;
+        binners[taskIndex].clear();
+        binners[taskIndex].bin(prims,k0,k1,mapping);
+      });
+
+    for (size_t i=0; i<taskCount; i++)
+      binner.merge(binners[i],mapping.size());
+  }
+
   template<typename BinInfoT, typename BinMapping, typename PrimRef>
   __forceinline void bin_parallel(BinInfoT& binner, const PrimRef* prims, size_t begin, size_t end, size_t blockSize, size_t parallelThreshold, const BinMapping& mapping)
   {
     if (likely(end-begin < parallelThreshold)) {
       binner.bin(prims,begin,end,mapping);
     } else {
-      binner = parallel_reduce(begin,end,blockSize,binner,
-                              [&](const range<size_t>& r) -> BinInfoT { BinInfoT binner(empty); binner.bin(prims + r.begin(), r.size(), mapping); return binner; },
-                              [&](const BinInfoT& b0, const BinInfoT& b1) -> BinInfoT { BinInfoT r = b0; r.merge(b1, mapping.size()); return r; });
+      bin_parallel_threadlocal(binner,prims,begin,end,blockSize,mapping);
     }
   }
 
@@ -931,9 +993,7 @@ namespace embree
     if (!parallel) {
       binner.bin(prims,begin,end,mapping);
     } else {
-      binner = parallel_reduce(begin,end,blockSize,binner,
-                              [&](const range<size_t>& r) -> BinInfoT { BinInfoT binner(empty); binner.bin(prims + r.begin(), r.size(), mapping); return binner; },
-                              [&](const BinInfoT& b0, const BinInfoT& b1) -> BinInfoT { BinInfoT r = b0; r.merge(b1, mapping.size()); return r; });
+      bin_parallel_threadlocal(binner,prims,begin,end,blockSize,mapping);
     }
   }
 
@@ -26,6 +26,7 @@ namespace embree
     template<typename Mesh>
     PrimInfo createPrimRefArray(Mesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
     {
+      TraceScope trace("createPrimRefArray");
       ParallelPrefixSumState<PrimInfo> pstate;
       /* first try */
       progressMonitor(0);
@@ -67,9 +68,56 @@ namespace embree
       return pinfo;
     }
 
+    template<typename Mesh>
+    PrimInfo createPrimRefArray(Mesh* mesh, const range<size_t>& src, mvector<PrimRef>& prims, size_t dst, BuildProgressMonitor& progressMonitor)
+    {
+      if (src.size() == 0) return PrimInfo(empty);
+      assert(dst+src.size() <= prims.size());
+
+      ParallelPrefixSumState<PrimInfo> pstate;
+      /* first try */
+      progressMonitor(0);
+      PrimInfo pinfo = parallel_prefix_sum( pstate, src.begin(), src.end(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo
+      {
+        size_t k = dst+r.begin()-src.begin();
+        PrimInfo pinfo(empty);
+        for (size_t j=r.begin(); j<r.end(); j++)
+        {
+          BBox3fa bounds = empty;
+          if (!mesh->buildBounds(j,&bounds)) continue;
+          const PrimRef prim(bounds,mesh->id,unsigned(j));
+          pinfo.add(bounds,bounds.center2());
+          prims[k++] = prim;
+        }
+        return pinfo;
+      }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+
+      /* if we need to filter out geometry, run again */
+      if (pinfo.size() != src.size())
+      {
+        progressMonitor(0);
+        pinfo = parallel_prefix_sum( pstate, src.begin(), src.end(), size_t(1024), PrimInfo(empty), [&](const range<size_t>& r, const PrimInfo& base) -> PrimInfo
+        {
+          size_t k = dst+base.size();
+          PrimInfo pinfo(empty);
+          for (size_t j=r.begin(); j<r.end(); j++)
+          {
+            BBox3fa bounds = empty;
+            if (!mesh->buildBounds(j,&bounds)) continue;
+            const PrimRef prim(bounds,mesh->id,unsigned(j));
+            pinfo.add(bounds,bounds.center2());
+            prims[k++] = prim;
+          }
+          return pinfo;
+        }, [](const PrimInfo& a, const PrimInfo& b) -> PrimInfo { return PrimInfo::merge(a,b); });
+      }
+      return pinfo;
+    }
+
     template<typename Mesh, bool mblur>
     PrimInfo createPrimRefArray(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
     {
+      TraceScope trace("createPrimRefArray");
       ParallelForForPrefixSumState<PrimInfo> pstate;
       Scene::Iterator<Mesh,mblur> iter(scene);
       
@@ -115,6 +163,7 @@ namespace embree
     template<typename Mesh>
     PrimInfo createPrimRefArrayMBlur(size_t timeSegment, size_t numTimeSteps, Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor)
     {
+      TraceScope trace("createPrimRefArray");
       ParallelForForPrefixSumState<PrimInfo> pstate;
       Scene::Iterator<Mesh,true> iter(scene);
 
@@ -345,6 +394,12 @@ namespace embree
     IF_ENABLED_LINES(template PrimInfo createPrimRefArray<LineSegments>(LineSegments* mesh COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_USER(template PrimInfo createPrimRefArray<AccelSet>(AccelSet* mesh COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
 
+    IF_ENABLED_TRIS (template PrimInfo createPrimRefArray<TriangleMesh>(TriangleMesh* mesh COMMA const range<size_t>& src COMMA mvector<PrimRef>& prims COMMA size_t dst COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_QUADS(template PrimInfo createPrimRefArray<QuadMesh>(QuadMesh* mesh COMMA const range<size_t>& src COMMA mvector<PrimRef>& prims COMMA size_t dst COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_HAIR (template PrimInfo createPrimRefArray<NativeCurves>(NativeCurves* mesh COMMA const range<size_t>& src COMMA mvector<PrimRef>& prims COMMA size_t dst COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_LINES(template PrimInfo createPrimRefArray<LineSegments>(LineSegments* mesh COMMA const range<size_t>& src COMMA mvector<PrimRef>& prims COMMA size_t dst COMMA BuildProgressMonitor& progressMonitor));
+    IF_ENABLED_USER(template PrimInfo createPrimRefArray<AccelSet>(AccelSet* mesh COMMA const range<size_t>& src COMMA mvector<PrimRef>& prims COMMA size_t dst COMMA BuildProgressMonitor& progressMonitor));
+
     IF_ENABLED_TRIS (template PrimInfo createPrimRefArray<TriangleMesh COMMA false>(Scene* scene COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_TRIS (template PrimInfo createPrimRefArray<TriangleMesh COMMA true>(Scene* scene COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
     IF_ENABLED_QUADS(template PrimInfo createPrimRefArray<QuadMesh COMMA false>(Scene* scene COMMA mvector<PrimRef>& prims COMMA BuildProgressMonitor& progressMonitor));
@@ -29,6 +29,9 @@ namespace embree
     template<typename Mesh>
       PrimInfo createPrimRefArray(Mesh* mesh, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
+    template<typename Mesh>
+      PrimInfo createPrimRefArray(Mesh* mesh, const range<size_t>& src, mvector<PrimRef>& prims, size_t dst, BuildProgressMonitor& progressMonitor);
+
     template<typename Mesh, bool mblur>
       PrimInfo createPrimRefArray(Scene* scene, mvector<PrimRef>& prims, BuildProgressMonitor& progressMonitor);
 
@@ -38,6 +41,21 @@ namespace embree
     PrimInfo createBezierRefArray(Scene* scene, mvector<BezierPrim>& prims, BuildProgressMonitor& progressMonitor);
     PrimInfo createBezierRefArrayMBlur(size_t timeSegment, size_t numTimeSteps, Scene* scene, mvector<BezierPrim>& prims, BuildProgressMonitor& progressMonitor);
 
+    /*! resizes a primref array that is kept alive across builds, the
+     *  array grows with some slack to avoid reallocations for growing
+     *  geometry and gets released if it exceeds retentionFactor times
+     *  the required size */
+    template<typename Ty>
+      __forceinline void resizeRetained(mvector<Ty>& prims, const size_t numPrimitives, const float retentionFactor)
+    {
+      if (retentionFactor > 0.0f && (prims.capacity() < numPrimitives || prims.capacity() > retentionFactor*numPrimitives)) 
+      {
+        prims.clear();
+        prims.reserve(size_t(clamp(retentionFactor,1.0f,1.25f)*numPrimitives));
+      }
+      prims.resize(numPrimitives);
+    }
+
     template<typename Mesh>
       size_t createMortonCodeArray(Mesh* mesh, mvector<BVHBuilderMorton::BuildPrim>& morton, BuildProgressMonitor& progressMonitor);
     
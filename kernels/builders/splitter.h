@@ -175,6 +175,70 @@ namespace embree
     private:
       const Scene* scene;
     };
+
+    struct LineSegmentsSplitter
+    {
+      __forceinline LineSegmentsSplitter(const Scene* scene, const PrimRef& prim)
+      {
+        const LineSegments* mesh = (const LineSegments*) scene->get(prim.geomID() & 0x00FFFFFF );  
+        const unsigned int index = mesh->segment(prim.primID());
+        v0 = mesh->vertex(index+0);
+        v1 = mesh->vertex(index+1);
+        radius = Vec3fa(max(v0.w,v1.w));
+      }
+
+      /* clips the full segment against the split plane and enlarges both
+         halves by the radius, every point of the swept sphere is within
+         radius distance of a segment point of one of the halves */
+      __forceinline void split(const BBox3fa& bounds, const size_t dim, const float pos, BBox3fa& left_o, BBox3fa& right_o) const
+      {
+        BBox3fa left = empty, right = empty;
+        const float v0d = v0[dim];
+        const float v1d = v1[dim];
+        if (v0d <= pos) left. extend(v0); 
+        if (v0d >= pos) right.extend(v0);
+        if (v1d <= pos) left. extend(v1); 
+        if (v1d >= pos) right.extend(v1);
+        
+        if ((v0d < pos && pos < v1d) || (v1d < pos && pos < v0d)) // the segment crosses the splitting location
+        {
+          const Vec3fa c = madd(Vec3fa((pos-v0d)/(v1d-v0d)),v1-v0,v0);
+          left.extend(c);
+          right.extend(c);
+        }
+        
+        left_o  = left .empty() ? BBox3fa(empty) : intersect(enlarge(left ,radius),bounds);
+        right_o = right.empty() ? BBox3fa(empty) : intersect(enlarge(right,radius),bounds);
+      }
+      
+      __forceinline void operator() (const PrimRef& prim, const size_t dim, const float pos, PrimRef& left_o, PrimRef& right_o) const 
+      {
+        BBox3fa left, right;
+        split(prim.bounds(),dim,pos,left,right);
+        new (&left_o ) PrimRef(left ,prim.geomID(), prim.primID());
+        new (&right_o) PrimRef(right,prim.geomID(), prim.primID());
+      }
+      
+      __forceinline void operator() (const BBox3fa& prim, const size_t dim, const float pos, BBox3fa& left_o, BBox3fa& right_o) const {
+        split(prim,dim,pos,left_o,right_o);
+      }
+      
+    private:
+      Vec3fa v0, v1;
+      Vec3fa radius;
+    };
+    
+    struct LineSegmentsSplitterFactory
+    {
+      __forceinline LineSegmentsSplitterFactory(const Scene* scene)
+        : scene(scene) {}
+      
+      __forceinline LineSegmentsSplitter operator() (const PrimRef& prim) const {
+        return LineSegmentsSplitter(scene,prim);
+      }
+      
+    private:
+      const Scene* scene;
+    };
   }
 }
-
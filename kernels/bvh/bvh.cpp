@@ -135,6 +135,9 @@ namespace embree
     if (device->verbosity(1))
       std::cout << "building BVH" << N << "<" << primTy.name << "> using " << builderName << " ..." << std::flush;
 
+    if (Tracing::enabled())
+      Tracing::begin(Tracing::intern(builderName));
+
     double t0 = 0.0;
     if (device->benchmark || device->verbosity(1)) t0 = getSeconds();
     return t0;
@@ -145,6 +148,9 @@ namespace embree
   {
     if (t0 == double(inf))
       return;
+
+    if (Tracing::enabled())
+      Tracing::end();
     
     double dt = 0.0;
     if (device->benchmark || device->verbosity(1)) 
@@ -1201,9 +1201,13 @@ namespace embree
       alloc.shrink();
     }
 
-    /*! post build cleanup */
-    void cleanup() {
-      alloc.cleanup();
+    /*! post build cleanup, dynamic scenes keep allocator state and
+     *  some unused blocks alive for the next commit */
+    void cleanup() 
+    {
+      const float retentionFactor = device->build_retention_factor;
+      if (scene->isStatic() || retentionFactor <= 0.0f) alloc.cleanup();
+      else alloc.retain(size_t(max(0.0f,retentionFactor-1.0f)*alloc.getUsedBytes()));
     }
 
 
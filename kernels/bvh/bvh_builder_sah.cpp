@@ -26,6 +26,7 @@
 #include "../geometry/triangle.h"
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglei.h"
+#include "../geometry/trianglemeshlet.h"
 #include "../geometry/trianglev_mb.h"
 #include "../geometry/trianglei_mb.h"
 #include "../geometry/quadv.h"
@@ -45,6 +46,7 @@ namespace embree
     MAYBE_UNUSED static const float travCost = 1.0f;
     MAYBE_UNUSED static const size_t DEFAULT_SINGLE_THREAD_THRESHOLD = 1024;
     MAYBE_UNUSED static const size_t HIGH_SINGLE_THREAD_THRESHOLD    = 3*1024;
+    MAYBE_UNUSED static const size_t MIN_PARTITION_PRIMITIVES        = 64*1024;
 
     typedef FastAllocator::ThreadLocal2 Allocator;
 
@@ -74,6 +76,37 @@ namespace embree
       PrimRef* prims;
     };
 
+#if defined(EMBREE_GEOMETRY_TRIANGLES)
+
+    /* the number of triangles stored in a meshlet depends on how many vertices they share */
+    template<int N>
+    struct CreateLeaf<N,TriangleMeshlet>
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+
+      __forceinline CreateLeaf (BVH* bvh, PrimRef* prims) : bvh(bvh), prims(prims) {}
+      
+      template<typename BuildRecord>
+      __forceinline NodeRef operator() (const BuildRecord& current, Allocator* alloc) const
+      {
+        size_t start = current.prims.begin();
+        size_t items = TriangleMeshlet::blocks(prims,start,current.prims.end(),bvh->scene);
+        assert(items <= BVH::maxLeafBlocks);
+        TriangleMeshlet* accel = (TriangleMeshlet*) alloc->alloc1->malloc(items*sizeof(TriangleMeshlet),BVH::byteAlignment);
+        typename BVH::NodeRef node = BVH::encodeLeaf((char*)accel,items);
+        for (size_t i=0; i<items; i++) {
+          accel[i].fill(prims,start,current.prims.end(),bvh->scene);
+        }
+        assert(start == current.prims.end());
+        return node;
+      }
+
+      BVH* bvh;
+      PrimRef* prims;
+    };
+
+#endif
 
     template<int N, typename Primitive>
     struct CreateLeafQuantized
@@ -127,13 +160,76 @@ namespace embree
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
+      /*! builds a BVH for each partition of at most numPartitionPrimitives many primitives and stitches them together */
+      PrimInfo buildPartitioned(const size_t numPrimitives, const size_t numPartitionPrimitives, NodeRef& root)
+      {
+        prims.resize(numPartitionPrimitives);
+        bvh->alloc.init_estimate(numPrimitives*sizeof(PrimRef),settings.singleThreadThreshold != DEFAULT_SINGLE_THREAD_THRESHOLD);
+
+        std::vector<NodeRef> roots;
+        std::vector<PrimInfo> rootInfos;
+        PrimInfo pinfo(empty);
+        auto buildPartition = [&] () 
+        {
+          if (pinfo.size() == 0) return;
+          roots.push_back(BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeaf<N,Primitive>(bvh,prims.data()),bvh->scene->progressInterface,prims.data(),pinfo,settings));
+          rootInfos.push_back(pinfo);
+          pinfo = PrimInfo(empty);
+        };
+
+        /* fill the primref array partition by partition */
+        auto addMesh = [&] (Mesh* mesh) 
+        {
+          for (size_t begin=0; begin<mesh->size(); )
+          {
+            const size_t end = min(mesh->size(),begin+numPartitionPrimitives-pinfo.size());
+            pinfo.merge(createPrimRefArray<Mesh>(mesh,range<size_t>(begin,end),prims,pinfo.size(),bvh->scene->progressInterface));
+            if (pinfo.size() == numPartitionPrimitives) buildPartition();
+            begin = end;
+          }
+        };
+        if (mesh) addMesh(mesh);
+        else {
+          Scene::Iterator<Mesh,false> iter(scene);
+          for (size_t i=0; i<iter.size(); i++)
+            if (Mesh* mesh = iter[i]) addMesh(mesh);
+        }
+        buildPartition();
+        prims.clear();
+
+        PrimInfo total(empty);
+        for (size_t i=0; i<rootInfos.size(); i++) 
+          total.merge(rootInfos[i]);
+
+        if (roots.size() <= 1) {
+          root = roots.size() ? roots[0] : NodeRef(BVH::emptyNode);
+          return total;
+        }
+
+        /* stitch partitions together by building a BVH over their roots */
+        mvector<PrimRef> refs(bvh->device,roots.size());
+        for (size_t i=0; i<roots.size(); i++)
+          refs[i] = PrimRef(rootInfos[i].geomBounds,i);
+        PrimInfo rinfo(roots.size(),total.geomBounds,empty);
+        for (size_t i=0; i<roots.size(); i++) 
+          rinfo.centBounds.extend(center2(rootInfos[i].geomBounds));
+
+        GeneralBVHBuilder::Settings rsettings(1,1,1,travCost,1.0f,DEFAULT_SINGLE_THREAD_THRESHOLD);
+        root = BVHNBuilderVirtual<N>::build(&bvh->alloc,[&] (const BVHBuilderBinnedSAH::BuildRecord& current, Allocator* alloc) -> NodeRef {
+            assert(current.prims.size() == 1);
+            return roots[refs[current.prims.begin()].ID()];
+          },bvh->scene->progressInterface,refs.data(),rinfo,rsettings);
+        return total;
+      }
+
       void build() 
       {
-        /* we reset the allocator when the mesh size changed */
+        /* we reset the allocator when the mesh size changed, unless its blocks get retained for reuse */
         if (mesh && mesh->numPrimitivesChanged) {
-          bvh->alloc.clear();
+          if (bvh->device->build_retention_factor <= 0.0f) bvh->alloc.clear();
           mesh->numPrimitivesChanged = false;
         }
+        const bool staticGeom = mesh ? mesh->isStatic() : scene->isStatic();
 
 	/* skip build for empty scene */
         const size_t numPrimitives = mesh ? mesh->size() : scene->getNumPrimitives<Mesh,false>();
@@ -145,12 +241,31 @@ namespace embree
         
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderSAH");
 
+        /* build in partitions if the primref array would exceed the build memory limit */
+        const size_t buildMemoryLimit = bvh->device->build_memory_limit;
+        const size_t numPartitionPrimitives = max(buildMemoryLimit/sizeof(PrimRef),MIN_PARTITION_PRIMITIVES);
+        if (buildMemoryLimit && numPrimitives > numPartitionPrimitives)
+        {
+          NodeRef root;
+          const PrimInfo pinfo = buildPartitioned(numPrimitives,numPartitionPrimitives,root);
+          if (unlikely(pinfo.size() == 0)) {
+            bvh->clear();
+            return;
+          }
+          bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+          bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+          if (staticGeom) bvh->shrink();
+          bvh->cleanup();
+          bvh->postBuild(t0);
+          return;
+        }
+
 #if PROFILE
         profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
 #endif
 
             /* create primref array */
-            prims.resize(numPrimitives);
+            resizeRetained(prims,numPrimitives,staticGeom ? 0.0f : bvh->device->build_retention_factor);
             PrimInfo pinfo = mesh ? 
               createPrimRefArray<Mesh>  (mesh ,prims,bvh->scene->progressInterface) : 
               createPrimRefArray<Mesh,false>(scene,prims,bvh->scene->progressInterface);
@@ -174,8 +289,6 @@ namespace embree
 #endif	
 
 	/* clear temporary data for static geometry */
-	bool staticGeom = mesh ? mesh->isStatic() : scene->isStatic();
-
 	if (staticGeom) {
 #if 0
           bvh->primrefs = std::move(prims);
@@ -220,11 +333,12 @@ namespace embree
 
       void build() 
       {
-        /* we reset the allocator when the mesh size changed */
+        /* we reset the allocator when the mesh size changed, unless its blocks get retained for reuse */
         if (mesh && mesh->numPrimitivesChanged) {
-          bvh->alloc.clear();
+          if (bvh->device->build_retention_factor <= 0.0f) bvh->alloc.clear();
           mesh->numPrimitivesChanged = false;
         }
+        const bool staticGeom = mesh ? mesh->isStatic() : scene->isStatic();
 
 	/* skip build for empty scene */
         const size_t numPrimitives = mesh ? mesh->size() : scene->getNumPrimitives<Mesh,false>();
@@ -240,7 +354,7 @@ namespace embree
         profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
 #endif
             /* create primref array */
-            prims.resize(numPrimitives);
+            resizeRetained(prims,numPrimitives,staticGeom ? 0.0f : bvh->device->build_retention_factor);
             PrimInfo pinfo = mesh ? 
               createPrimRefArray<Mesh>  (mesh ,prims,bvh->scene->progressInterface) : 
               createPrimRefArray<Mesh,false>(scene,prims,bvh->scene->progressInterface);
@@ -255,7 +369,6 @@ namespace embree
 #endif	
 
 	/* clear temporary data for static geometry */
-	bool staticGeom = mesh ? mesh->isStatic() : scene->isStatic();
 	if (staticGeom) {
           prims.clear();
           bvh->shrink();
@@ -330,7 +443,7 @@ namespace embree
         /* allocate buffers */
         bvh->numTimeSteps = scene->getNumTimeSteps<Mesh,true>();
         const size_t numTimeSegments = bvh->numTimeSteps-1; assert(bvh->numTimeSteps > 1);
-        prims.resize(numPrimitives);
+        resizeRetained(prims,numPrimitives,scene->isStatic() ? 0.0f : bvh->device->build_retention_factor);
         bvh->alloc.init_estimate(numPrimitives*sizeof(PrimRef)*numTimeSegments,settings.singleThreadThreshold != DEFAULT_SINGLE_THREAD_THRESHOLD);
         NodeRef* roots = (NodeRef*) bvh->alloc.threadLocal()->malloc(sizeof(NodeRef)*numTimeSegments,BVH::byteNodeAlignment);
 
@@ -394,7 +507,7 @@ namespace embree
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Mesh* mesh, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode, const size_t singleThreadThreshold = DEFAULT_SINGLE_THREAD_THRESHOLD)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims0(bvh->device), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, singleThreadThreshold),
-          splitFactor(scene->device->max_spatial_split_replications) {}
+          splitFactor(bvh->device->max_spatial_split_replications) {}
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
@@ -416,8 +529,11 @@ namespace embree
 
         double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderFastSpatialSAH");
 
-        /* create primref array */
-        const size_t numSplitPrimitives = max(numOriginalPrimitives,size_t(splitFactor*numOriginalPrimitives));
+        /* create primref array, replications for spatial splits are limited by the build memory limit */
+        size_t numSplitPrimitives = max(numOriginalPrimitives,size_t(splitFactor*numOriginalPrimitives));
+        const size_t buildMemoryLimit = bvh->device->build_memory_limit;
+        if (buildMemoryLimit) 
+          numSplitPrimitives = max(numOriginalPrimitives,min(numSplitPrimitives,buildMemoryLimit/sizeof(PrimRef)));
         prims0.resize(numSplitPrimitives);
         PrimInfo pinfo = mesh ? 
           createPrimRefArray<Mesh>  (mesh ,prims0,bvh->scene->progressInterface) : 
@@ -469,9 +585,11 @@ namespace embree
     Builder* BVH4Line4iMeshBuilderSAH     (void* bvh, LineSegments* mesh, size_t mode) { return new BVHNBuilderSAH<4,LineSegments,Line4i>((BVH4*)bvh,mesh,4,1.0f,4,inf,mode,HIGH_SINGLE_THREAD_THRESHOLD); }
     Builder* BVH4Line4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,LineSegments,Line4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode,HIGH_SINGLE_THREAD_THRESHOLD); }
     Builder* BVH4Line4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<4,LineSegments,Line4i>((BVH4*)bvh,scene ,4,1.0f,4,inf,HIGH_SINGLE_THREAD_THRESHOLD); }
+    Builder* BVH4Line4iSceneBuilderFastSpatialSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<4,LineSegments,Line4i,LineSegmentsSplitterFactory>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
 #if defined(__AVX__)
     Builder* BVH8Line4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,LineSegments,Line4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode,HIGH_SINGLE_THREAD_THRESHOLD); }
     Builder* BVH8Line4iMBSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderMSMBlurSAH<8,LineSegments,Line4i>((BVH8*)bvh,scene,4,1.0f,4,inf,HIGH_SINGLE_THREAD_THRESHOLD); }
+    Builder* BVH8Line4iSceneBuilderFastSpatialSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<8,LineSegments,Line4i,LineSegmentsSplitterFactory>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
 #endif
 #endif
 
@@ -498,6 +616,7 @@ namespace embree
 
 
     Builder* BVH4QuantizedTriangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,TriangleMesh,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4TriangleMeshletSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,TriangleMesh,TriangleMeshlet>((BVH4*)bvh,scene,8,1.0f,8,TriangleMeshlet::min_size()*BVH4::maxLeafBlocks,mode); }
 #if defined(__AVX__)
     Builder* BVH8Triangle4MeshBuilderSAH  (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,Triangle4>((BVH8*)bvh,mesh,4,1.0f,4,inf,mode); }
     Builder* BVH8Triangle4vMeshBuilderSAH (void* bvh, TriangleMesh* mesh, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,Triangle4v>((BVH8*)bvh,mesh,4,1.0f,4,inf,mode); }
@@ -509,6 +628,7 @@ namespace embree
     Builder* BVH8Triangle4vMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMSMBlurSAH<8,TriangleMesh,Triangle4vMB>((BVH8*)bvh,scene,4,1.0f,4,inf,HIGH_SINGLE_THREAD_THRESHOLD); }
     Builder* BVH8Triangle4iMBSceneBuilderSAH (void* bvh, Scene* scene,       size_t mode) { return new BVHNBuilderMSMBlurSAH<8,TriangleMesh,Triangle4iMB>((BVH8*)bvh,scene,4,1.0f,4,inf,HIGH_SINGLE_THREAD_THRESHOLD); }
     Builder* BVH8QuantizedTriangle4iSceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,TriangleMesh,Triangle4i>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH8TriangleMeshletSceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,TriangleMesh,TriangleMeshlet>((BVH8*)bvh,scene,8,1.0f,8,TriangleMeshlet::min_size()*BVH8::maxLeafBlocks,mode); }
     Builder* BVH8Triangle4SceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<8,TriangleMesh,Triangle4,TriangleSplitterFactory>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH8Triangle4vSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<8,TriangleMesh,Triangle4v,TriangleSplitterFactory>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
 
@@ -524,6 +644,7 @@ namespace embree
     Builder* BVH4QuantizedQuad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4QuantizedQuad4iSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,QuadMesh,Quad4i>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
     Builder* BVH4Quad4vSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<4,QuadMesh,Quad4v,QuadSplitterFactory>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
+    Builder* BVH4Quad4iSceneBuilderFastSpatialSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderFastSpatialSAH<4,QuadMesh,Quad4i,QuadSplitterFactory>((BVH4*)bvh,scene,4,1.0f,4,inf,mode); }
 
 #if defined(__AVX__)
     Builder* BVH8Quad4vSceneBuilderSAH     (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<8,QuadMesh,Quad4v>((BVH8*)bvh,scene,4,1.0f,4,inf,mode); }
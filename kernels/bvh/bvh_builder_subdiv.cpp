@@ -57,9 +57,10 @@ namespace embree
 
 #define SUBGRID 9
 
+      /* has to match the tiling of createEager, neighbouring leaves share one row/column of vertices */
       static unsigned getNumEagerLeaves(unsigned width, unsigned height) {
-        const unsigned w = (width+SUBGRID-1)/SUBGRID;
-        const unsigned h = (width+SUBGRID-1)/SUBGRID;
+        const unsigned w = (width-1+SUBGRID-2)/(SUBGRID-1);
+        const unsigned h = (height-1+SUBGRID-2)/(SUBGRID-1);
         return w*h;
       }
 
@@ -84,6 +85,100 @@ namespace embree
         return NN;
       }
 
+      /* collects the subgrids of many patches to displace all of them with a single call of the batched displacement function */
+      struct DisplacementBatch
+      {
+        enum { MAX_POINTS = 16*1024 };
+        enum { GRID_STRIDE = (SUBGRID*SUBGRID+VSIZEX+15)/16*16 }; // keeps each temporary subgrid array 64 bytes aligned
+
+        struct Subgrid
+        {
+          unsigned primID;
+          unsigned x0,x1,y0,y1;
+          unsigned offset;  //!< offset of first point in batch arrays
+          PrimRef* prim;    //!< receives the leaf of the subgrid
+        };
+
+        DisplacementBatch (SubdivMesh* mesh, FastAllocator::ThreadLocal& alloc)
+          : mesh(mesh), alloc(alloc), numPoints(0)
+        {
+          /* arrays are padded to allow wide vector processing inside the displacement function */
+          for (size_t i=0; i<8; i++) data[i] = (float*) alignedMalloc((MAX_POINTS+VSIZEX)*sizeof(float),64);
+          primIDs = (unsigned*) alignedMalloc((MAX_POINTS+VSIZEX)*sizeof(unsigned),64);
+          times   = (unsigned*) alignedMalloc((MAX_POINTS+VSIZEX)*sizeof(unsigned),64);
+          memset(times,0,(MAX_POINTS+VSIZEX)*sizeof(unsigned));
+        }
+
+        ~DisplacementBatch ()
+        {
+          for (size_t i=0; i<8; i++) alignedFree(data[i]);
+          alignedFree(primIDs);
+          alignedFree(times);
+        }
+
+        /*! number of subgrids waiting for displacement */
+        __forceinline size_t size() const { return subgrids.size(); }
+
+        /*! evaluates the undisplaced subgrids of some patch using the same tiling as createEager */
+        unsigned add(const SubdivPatch1Base& patch, PrimRef* prims, PrimInfo& pinfo)
+        {
+          unsigned NN = 0;
+          const unsigned x0 = 0, x1 = patch.grid_u_res-1;
+          const unsigned y0 = 0, y1 = patch.grid_v_res-1;
+
+          for (unsigned y=y0; y<y1; y+=SUBGRID-1)
+          {
+            for (unsigned x=x0; x<x1; x+=SUBGRID-1) 
+            {
+              const unsigned lx0 = x, lx1 = min(lx0+SUBGRID-1,x1);
+              const unsigned ly0 = y, ly1 = min(ly0+SUBGRID-1,y1);
+              const unsigned n = (lx1-lx0+1)*(ly1-ly0+1);
+              if (numPoints+n > MAX_POINTS) flush(pinfo);
+
+              __aligned(64) float grid[8][GRID_STRIDE];
+              evalGridNormals(patch,lx0,lx1,ly0,ly1,patch.grid_u_res,patch.grid_v_res,
+                              grid[0],grid[1],grid[2],grid[3],grid[4],grid[5],grid[6],grid[7],mesh);
+              for (size_t i=0; i<8; i++) memcpy(&data[i][numPoints],grid[i],n*sizeof(float));
+              for (size_t i=0; i<n; i++) primIDs[numPoints+i] = patch.prim;
+
+              const Subgrid subgrid = { patch.prim, lx0, lx1, ly0, ly1, numPoints, prims++ };
+              subgrids.push_back(subgrid);
+              numPoints += n;
+              NN++;
+            }
+          }
+          return NN;
+        }
+
+        /*! displaces all collected points and creates the leaves of the subgrids */
+        void flush(PrimInfo& pinfo)
+        {
+          if (numPoints == 0) return;
+          mesh->displFuncN(mesh->userPtr,mesh->id,primIDs,times,data[3],data[4],data[5],data[6],data[7],data[0],data[1],data[2],numPoints);
+
+          for (const Subgrid& g : subgrids)
+          {
+            BBox3fa bounds;
+            GridSOA* leaf = GridSOA::create(mesh->id,g.primID,g.x0,g.x1,g.y0,g.y1,
+                                            &data[0][g.offset],&data[1][g.offset],&data[2][g.offset],&data[3][g.offset],&data[4][g.offset],
+                                            alloc,&bounds);
+            *g.prim = PrimRef(bounds,BVH4::encodeTypedLeaf(leaf,1));
+            pinfo.add(g.prim->bounds());
+          }
+          subgrids.clear();
+          numPoints = 0;
+        }
+
+      private:
+        SubdivMesh* mesh;
+        FastAllocator::ThreadLocal& alloc;
+        std::vector<Subgrid> subgrids;
+        unsigned numPoints;
+        float* data[8];      //!< x, y, z, u, v, Ng_x, Ng_y, Ng_z arrays
+        unsigned* primIDs;
+        unsigned* times;
+      };
+
       void build() 
       {
         /* initialize all half edge structures */
@@ -149,6 +244,26 @@ namespace embree
           FastAllocator::ThreadLocal& alloc = *bvh->alloc.threadLocal();
           
           PrimInfo s(empty);
+
+          /* batched displacement functions get called for the subgrids of many patches at once */
+          if (mesh->displFuncN)
+          {
+            DisplacementBatch batch(mesh,alloc);
+            for (size_t f=r.begin(); f!=r.end(); ++f) {
+              if (!mesh->valid(f)) continue;
+            
+              patch_eval_subdivision(mesh->getHalfEdge(0,f),[&](const Vec2f uv[4], const int subdiv[4], const float edge_level[4], int subPatch)
+              {
+                SubdivPatch1Base patch(mesh->id,unsigned(f),subPatch,mesh,0,uv,edge_level,subdiv,VSIZEX);
+                size_t num = batch.add(patch,&prims[base.end+s.end+batch.size()],s);
+                assert(num == getNumEagerLeaves(patch.grid_u_res,patch.grid_v_res));
+                s.begin++;
+              });
+            }
+            batch.flush(s);
+            return s;
+          }
+
           for (size_t f=r.begin(); f!=r.end(); ++f) {
             if (!mesh->valid(f)) continue;
             
@@ -17,6 +17,7 @@
 #include "bvh_builder_twolevel.h"
 #include "bvh_statistics.h"
 #include "../builders/bvh_builder_sah.h"
+#include "../builders/primrefgen.h"
 #include "../common/scene_line_segments.h"
 #include "../common/scene_triangle_mesh.h"
 #include "../common/scene_quad_mesh.h"
@@ -137,7 +138,7 @@ namespace embree
         // PRINT(numPrimitives);
         // PRINT(refs.size());
         /* compute PrimRefs */
-        prims.resize(refs.size());
+        resizeRetained(prims,refs.size(),scene->device->build_retention_factor);
         bvh->alloc.init_estimate(refs.size()*16);
 
 #if defined(TASKING_TBB) && defined(__AVX512ER__) && USE_TASK_ARENA // KNL
@@ -199,7 +200,7 @@ namespace embree
 #if PROFILE
       }); 
 #endif
-      bvh->alloc.cleanup();
+      bvh->cleanup();
       bvh->postBuild(t0);
     }
     
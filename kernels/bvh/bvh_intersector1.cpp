@@ -23,11 +23,13 @@
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
+#include "../geometry/trianglemeshlet_intersector.h"
 #include "../geometry/trianglei_mb_intersector.h"
 #include "../geometry/quadv_intersector.h"
 #include "../geometry/quadi_intersector.h"
 #include "../geometry/quadi_mb_intersector.h"
 #include "../geometry/bezier1v_intersector.h"
+#include "../geometry/bezierq_intersector.h"
 #include "../geometry/bezier1i_intersector.h"
 #include "../geometry/linei_intersector.h"
 #include "../geometry/subdivpatch1eager_intersector.h"
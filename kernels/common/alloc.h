@@ -138,10 +138,14 @@ namespace embree
         if (alloc->use_single_mode) alloc1 = &allocators[0];
       }
       
-      /*! resets the allocator */
-      __forceinline void reset() {
+      /*! resets the allocator, picks up block size and mode of the next build */
+      __forceinline void reset() 
+      {
         allocators[0].reset();
         allocators[1].reset();
+        allocators[0].allocBlockSize = allocators[0].alloc->defaultBlockSize;
+        allocators[1].allocBlockSize = allocators[1].alloc->defaultBlockSize;
+        alloc1 = allocators[0].alloc->use_single_mode ? &allocators[0] : &allocators[1];
       }
 
       /*! returns amount of used bytes */
@@ -247,12 +251,13 @@ namespace embree
     void init_estimate(size_t bytesAllocate, const bool single_mode = false) 
     {      
       internal_fix_used_blocks();
-      if (usedBlocks.load() || freeBlocks.load()) { reset(); return; }
       /* single allocator mode ? */
       use_single_mode = single_mode; 
       defaultBlockSize = clamp(bytesAllocate/4,size_t(128),size_t(PAGE_SIZE+maxAlignment)); 
       /* if in memory conservative single_mode, reduce bytesAllocate/growSize by 2 */
       initGrowSizeAndNumSlots(single_mode == false ? bytesAllocate : bytesAllocate/2);
+      /* blocks of a previous build get reused */
+      if (usedBlocks.load() || freeBlocks.load()) reset();
     }
 
     /*! frees state not required after build */
@@ -268,6 +273,24 @@ namespace embree
       thread_local_allocators2.clear();
     }
 
+    /*! frees state not required after build, but keeps the thread
+     *  local allocators and up to maxFreeBytes of unused blocks alive
+     *  for the next build */
+    void retain(size_t maxFreeBytes) 
+    {
+      internal_fix_used_blocks();
+      
+      for (size_t t=0; t<thread_local_allocators2.threads.size(); t++) {
+	bytesUsed += thread_local_allocators2.threads[t]->getUsedBytes();
+        bytesWasted += thread_local_allocators2.threads[t]->getWastedBytes();
+        thread_local_allocators2.threads[t]->reset();
+      }
+
+      if (getFreeBytes() > maxFreeBytes) {
+        if (freeBlocks.load() != nullptr) freeBlocks.load()->clear_list(device); freeBlocks = nullptr;
+      }
+    }
+
     /*! shrinks all memory blocks to the actually used size */
     void shrink () 
     {
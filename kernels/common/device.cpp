@@ -65,6 +65,16 @@ namespace embree
     /*! set tessellation cache size */
     setCacheSize( State::tessellation_cache_size );
 
+    /*! enable second level cache for displaced grids */
+#if defined(EMBREE_GEOMETRY_SUBDIV)
+    if (State::grid_cache_size) 
+      resizeGridCache(State::grid_cache_size,State::grid_cache_file);
+#endif
+
+    /*! record build events if a trace file is configured */
+    if (State::trace_file != "")
+      Tracing::enable(true);
+
     /*! enable some floating point exceptions to catch bugs */
     if (State::float_exceptions)
     {
@@ -108,6 +118,9 @@ namespace embree
   {
     setCacheSize(0);
     exitTaskingSystem();
+
+    if (State::trace_file != "" && !Tracing::write(State::trace_file))
+      std::cerr << "Embree: cannot write trace file " << State::trace_file << std::endl;
   }
 
   std::string getEnabledTargets()
@@ -334,6 +347,9 @@ namespace embree
 
     /* create task scheduler */
     size_t maxNumThreads = getMaxNumThreads();
+#if defined(TASKING_INTERNAL)
+    TaskScheduler::setIdleSpinRounds(State::idle_spin_rounds);
+#endif
     TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads);
 #if USE_TASK_ARENA
     arena = make_unique(new tbb::task_arena((int)min(maxNumThreads,TaskScheduler::threadCount())));
@@ -372,6 +388,12 @@ namespace embree
 
     switch (parm) {
     case RTC_SOFTWARE_CACHE_SIZE: setCacheSize(val); break;
+    case RTC_TRACE_WRITE:
+      if (State::trace_file == "")
+        throw_RTCError(RTC_INVALID_OPERATION, "no trace file configured");
+      if (!Tracing::write(State::trace_file))
+        throw_RTCError(RTC_INVALID_OPERATION, "cannot write trace file");
+      break;
     default: throw_RTCError(RTC_INVALID_ARGUMENT, "unknown writable parameter"); break;
     };
   }
@@ -512,6 +534,10 @@ namespace embree
     case RTC_CONFIG_COMMIT_THREAD: return 1;
 #endif
 
+    case RTC_SOFTWARE_CACHE_HITS   : return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumHits();
+    case RTC_SOFTWARE_CACHE_MISSES : return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumMisses();
+    case RTC_SOFTWARE_CACHE_FLUSHES: return SharedLazyTessellationCache::sharedLazyTessellationCache.getNumFlushes();
+
     default: throw_RTCError(RTC_INVALID_ARGUMENT, "unknown readable parameter"); break;
     };
   }
@@ -126,6 +126,11 @@ namespace embree
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! enables view dependent tessellation for the geometry */
+    virtual void setTessellationView(const RTCTessellationView* view) {
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Set user data pointer. */
     virtual void setUserData (void* ptr);
       
@@ -187,6 +192,11 @@ namespace embree
       throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! Set batched displacement function. */
+    virtual void setDisplacementFunctionN (RTCDisplacementFuncN filter, RTCBounds* bounds) {
+      throw_RTCError(RTC_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Set intersection filter function for single rays. */
     virtual void setIntersectionFilterFunction (RTCFilterFunc filter, bool ispc = false);
     
@@ -283,6 +283,26 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetCommitPriority(RTCScene hscene, int priority) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetCommitPriority);
+    RTCORE_VERIFY_HANDLE(hscene);
+    scene->setCommitPriority(priority);
+    RTCORE_CATCH_END(scene->device);
+  }
+
+  RTCORE_API void rtcCancelCommit(RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcCancelCommit);
+    RTCORE_VERIFY_HANDLE(hscene);
+    scene->cancelCommit();
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcGetBounds(RTCScene hscene, RTCBounds& bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -1221,7 +1241,7 @@ namespace embree
     RTCORE_TRACE(rtcNewLineSegments);
     RTCORE_VERIFY_HANDLE(hscene);
 #if defined(EMBREE_GEOMETRY_LINES)
-    return scene->newLineSegments(flags,numSegments,numVertices,numTimeSteps);
+    return scene->newLineSegments(LineSegments::FLAT,flags,numSegments,numVertices,numTimeSteps);
 #else
     throw_RTCError(RTC_UNKNOWN_ERROR,"rtcNewLineSegments is not supported");
 #endif
@@ -1229,6 +1249,21 @@ namespace embree
     return -1;
   }
 
+  RTCORE_API unsigned rtcNewRoundLineSegments (RTCScene hscene, RTCGeometryFlags flags, size_t numSegments, size_t numVertices, size_t numTimeSteps)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcNewRoundLineSegments);
+    RTCORE_VERIFY_HANDLE(hscene);
+#if defined(EMBREE_GEOMETRY_LINES)
+    return scene->newLineSegments(LineSegments::ROUND,flags,numSegments,numVertices,numTimeSteps);
+#else
+    throw_RTCError(RTC_UNKNOWN_ERROR,"rtcNewRoundLineSegments is not supported");
+#endif
+    RTCORE_CATCH_END(scene->device);
+    return -1;
+  }
+
   RTCORE_API unsigned rtcNewSubdivisionMesh (RTCScene hscene, RTCGeometryFlags flags, size_t numFaces, size_t numEdges, size_t numVertices, 
                                              size_t numEdgeCreases, size_t numVertexCreases, size_t numHoles, size_t numTimeSteps) 
   {
@@ -1400,6 +1435,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetTessellationView (RTCScene hscene, unsigned geomID, const RTCTessellationView* view)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetTessellationView);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setTessellationView(view);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcSetUserData (RTCScene hscene, unsigned geomID, void* ptr) 
   {
     Scene* scene = (Scene*) hscene;
@@ -1478,6 +1524,17 @@ namespace embree
     RTCORE_CATCH_END(scene->device);
   }
 
+  RTCORE_API void rtcSetDisplacementFunctionN (RTCScene hscene, unsigned geomID, RTCDisplacementFuncN func, RTCBounds* bounds)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetDisplacementFunctionN);
+    RTCORE_VERIFY_HANDLE(hscene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    scene->get_locked(geomID)->setDisplacementFunctionN(func,bounds);
+    RTCORE_CATCH_END(scene->device);
+  }
+
   RTCORE_API void rtcSetIntersectFunction (RTCScene hscene, unsigned geomID, RTCIntersectFunc intersect) 
   {
     Scene* scene = (Scene*) hscene;
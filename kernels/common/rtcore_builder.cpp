@@ -33,10 +33,23 @@ namespace embree
 { 
   namespace isa // FIXME: support more ISAs for builders
   {
+    /*! internal node mirroring the hierarchy of the last build, used
+     *  for refitting and to produce the compact node array */
+    struct BuildNode
+    {
+      BBox3fa bounds;       //!< bounds of the subtree
+      void* user;           //!< node returned by the user callbacks
+      BuildNode** children; //!< children for inner nodes, nullptr for leaves
+      unsigned N;           //!< number of children for inner nodes, number of primitives for leaves
+      unsigned begin;       //!< index of first primitive for leaves
+      unsigned numNodes;    //!< number of nodes of the subtree including this node
+      unsigned index;       //!< index of node in compact node array
+    };
+
     struct BVH
     {
       BVH (Device* device)
-        : device(device), isStatic(false), allocator(device,true), morton_src(device), morton_tmp(device) {}
+        : device(device), isStatic(false), allocator(device,true), morton_src(device), morton_tmp(device), morton_prims(device), root(nullptr), compact(device) {}
 
     public:
       Device* device;
@@ -44,8 +57,133 @@ namespace embree
       FastAllocator allocator;
       mvector<BVHBuilderMorton::BuildPrim> morton_src;
       mvector<BVHBuilderMorton::BuildPrim> morton_tmp;
+      mvector<PrimRef> morton_prims;
+      BuildNode* root;                 //!< root of the hierarchy of the last build
+      mvector<RTCCompactNode> compact; //!< compact node array of the last compact build
     };
 
+    /*! subtrees with more nodes are processed in parallel */
+    static const size_t PARALLEL_NODE_THRESHOLD = 4096;
+
+    __forceinline BuildNode* createBuildNode(FastAllocator::ThreadLocal* alloc, size_t N)
+    {
+      BuildNode* node = (BuildNode*) alloc->malloc(sizeof(BuildNode),16);
+      node->bounds = empty;
+      node->user = nullptr;
+      node->children = (BuildNode**) alloc->malloc(N*sizeof(BuildNode*),sizeof(BuildNode*));
+      node->N = (unsigned) N;
+      node->begin = 0;
+      node->numNodes = 1;
+      node->index = 0;
+      return node;
+    }
+
+    __forceinline BuildNode* createBuildLeaf(FastAllocator::ThreadLocal* alloc, size_t begin, size_t N, const BBox3fa& bounds)
+    {
+      BuildNode* node = (BuildNode*) alloc->malloc(sizeof(BuildNode),16);
+      node->bounds = bounds;
+      node->user = nullptr;
+      node->children = nullptr;
+      node->N = (unsigned) N;
+      node->begin = (unsigned) begin;
+      node->numNodes = 1;
+      node->index = 0;
+      return node;
+    }
+
+    /*! links the children into an inner node and passes the children to the user callback */
+    __forceinline BuildNode* updateBuildNode(BuildNode* node, BuildNode** children, size_t N, RTCSetNodeChildrenFunc setNodeChildren, void* userPtr)
+    {
+      void* childptrs[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+      BBox3fa bounds = empty;
+      unsigned numNodes = 1;
+      for (size_t i=0; i<N; i++) {
+        node->children[i] = children[i];
+        childptrs[i] = children[i]->user;
+        bounds.extend(children[i]->bounds);
+        numNodes += children[i]->numNodes;
+      }
+      node->bounds = bounds;
+      node->numNodes = numNodes;
+      if (setNodeChildren) setNodeChildren(node->user,childptrs,N,userPtr);
+      return node;
+    }
+
+    /*! writes the subtree of node into the compact node array, the children of the node are stored at childBase */
+    void flattenBuildNode(BuildNode* node, RTCCompactNode* nodes, unsigned index, unsigned childBase)
+    {
+      node->index = index;
+      RTCCompactNode& cnode = nodes[index];
+      cnode.lower_x = node->bounds.lower.x; cnode.lower_y = node->bounds.lower.y; cnode.lower_z = node->bounds.lower.z;
+      cnode.upper_x = node->bounds.upper.x; cnode.upper_y = node->bounds.upper.y; cnode.upper_z = node->bounds.upper.z;
+
+      if (node->children == nullptr) {
+        cnode.offset = node->begin;
+        cnode.count = node->N | RTC_COMPACT_NODE_LEAF;
+        return;
+      }
+      cnode.offset = childBase;
+      cnode.count = node->N;
+
+      /* descendants of each child follow the children in subtree order */
+      unsigned base[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+      unsigned next = childBase + node->N;
+      for (size_t i=0; i<node->N; i++) {
+        base[i] = next;
+        next += node->children[i]->numNodes-1;
+      }
+
+      if (node->numNodes > PARALLEL_NODE_THRESHOLD) {
+        parallel_for(size_t(0), size_t(node->N), [&] (const range<size_t>& r) {
+            for (size_t i=r.begin(); i<r.end(); i++)
+              flattenBuildNode(node->children[i],nodes,childBase+(unsigned)i,base[i]);
+          });
+      } else {
+        for (size_t i=0; i<node->N; i++)
+          flattenBuildNode(node->children[i],nodes,childBase+(unsigned)i,base[i]);
+      }
+    }
+
+    /*! recomputes the bounds of the subtree of node bottom up */
+    BBox3fa refitBuildNode(BVH* bvh, BuildNode* node, const PrimRef* prims, RTCSetNodeBoundsFunc setNodeBounds, void* userPtr)
+    {
+      BBox3fa bounds = empty;
+      if (node->children == nullptr)
+      {
+        for (size_t i=node->begin; i<node->begin+node->N; i++)
+          bounds.extend(prims[i].bounds());
+      }
+      else
+      {
+        BBox3fa cbounds[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+        if (node->numNodes > PARALLEL_NODE_THRESHOLD) {
+          parallel_for(size_t(0), size_t(node->N), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++)
+                cbounds[i] = refitBuildNode(bvh,node->children[i],prims,setNodeBounds,userPtr);
+            });
+        } else {
+          for (size_t i=0; i<node->N; i++)
+            cbounds[i] = refitBuildNode(bvh,node->children[i],prims,setNodeBounds,userPtr);
+        }
+
+        const RTCBounds* pbounds[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+        for (size_t i=0; i<node->N; i++) {
+          bounds.extend(cbounds[i]);
+          pbounds[i] = (const RTCBounds*) &cbounds[i];
+        }
+        if (setNodeBounds && node->user) 
+          setNodeBounds(node->user,pbounds,node->N,userPtr);
+      }
+      node->bounds = bounds;
+
+      if (bvh->compact.size()) {
+        RTCCompactNode& cnode = bvh->compact[node->index];
+        cnode.lower_x = bounds.lower.x; cnode.lower_y = bounds.lower.y; cnode.lower_z = bounds.lower.z;
+        cnode.upper_x = bounds.upper.x; cnode.upper_y = bounds.upper.y; cnode.upper_z = bounds.upper.z;
+      }
+      return bounds;
+    }
+
     RTCORE_API RTCBVH rtcNewBVH(RTCDevice device)
     {
       RTCORE_CATCH_BEGIN;
@@ -56,23 +194,25 @@ namespace embree
       return nullptr;
     }
 
-    void* rtcBuildBVHMorton(BVH* bvh,
-                            const RTCBuildSettings& settings,
-                            RTCBuildPrimitive* prims_i,
-                            size_t numPrimitives,
-                            RTCCreateNodeFunc createNode,
-                            RTCSetNodeChildrenFunc setNodeChildren,
-                            RTCSetNodeBoundsFunc setNodeBounds,
-                            RTCCreateLeafFunc createLeaf,
-                            RTCBuildProgressFunc buildProgress,
-                            void* userPtr)
+    BuildNode* rtcBuildBVHMorton(BVH* bvh,
+                                 const RTCBuildSettings& settings,
+                                 RTCBuildPrimitive* prims_i,
+                                 size_t numPrimitives,
+                                 RTCCreateNodeFunc createNode,
+                                 RTCSetNodeChildrenFunc setNodeChildren,
+                                 RTCSetNodeBoundsFunc setNodeBounds,
+                                 RTCCreateLeafFunc createLeaf,
+                                 RTCBuildProgressFunc buildProgress,
+                                 void* userPtr)
     {
       /* initialize temporary arrays for morton builder */
       PrimRef* prims = (PrimRef*) prims_i;
       mvector<BVHBuilderMorton::BuildPrim>& morton_src = bvh->morton_src;
       mvector<BVHBuilderMorton::BuildPrim>& morton_tmp = bvh->morton_tmp;
+      mvector<PrimRef>& morton_prims = bvh->morton_prims;
       morton_src.resize(numPrimitives);
       morton_tmp.resize(numPrimitives);
+      morton_prims.resize(numPrimitives);
 
       /* compute centroid bounds */
       const BBox3fa centBounds = parallel_reduce ( size_t(0), numPrimitives, BBox3fa(empty), [&](const range<size_t>& r) -> BBox3fa {
@@ -93,7 +233,7 @@ namespace embree
         });
 
       /* start morton build */
-      std::pair<void*,BBox3fa> root = BVHBuilderMorton::build<std::pair<void*,BBox3fa>>(
+      BuildNode* root = BVHBuilderMorton::build<BuildNode*>(
         
         /* thread local allocator for fast allocations */
         [&] () -> FastAllocator::ThreadLocal* { 
@@ -101,33 +241,34 @@ namespace embree
         },
         
         /* lambda function that allocates BVH nodes */
-        [&] ( FastAllocator::ThreadLocal* alloc, size_t N ) -> void* {
-          return createNode((RTCThreadLocalAllocator)alloc,N,userPtr);
+        [&] ( FastAllocator::ThreadLocal* alloc, size_t N ) -> BuildNode* {
+          BuildNode* node = createBuildNode(alloc,N);
+          if (createNode) node->user = createNode((RTCThreadLocalAllocator)alloc,N,userPtr);
+          return node;
         },
         
         /* lambda function that sets bounds */
-        [&] (void* node, const std::pair<void*,BBox3fa>* children, size_t N) -> std::pair<void*,BBox3fa>
+        [&] (BuildNode* node, BuildNode* const* children, size_t N) -> BuildNode*
         {
-          BBox3fa bounds = empty;
-          void* childptrs[BVHBuilderMorton::MAX_BRANCHING_FACTOR];
-          const RTCBounds* cbounds[BVHBuilderMorton::MAX_BRANCHING_FACTOR];
-          for (size_t i=0; i<N; i++) {
-            bounds.extend(children[i].second);
-            childptrs[i] = children[i].first;
-            cbounds[i] = (const RTCBounds*)&children[i].second;
+          if (setNodeBounds) {
+            const RTCBounds* cbounds[BVHBuilderMorton::MAX_BRANCHING_FACTOR];
+            for (size_t i=0; i<N; i++) cbounds[i] = (const RTCBounds*)&children[i]->bounds;
+            setNodeBounds(node->user,cbounds,N,userPtr);
           }
-          setNodeBounds(node,cbounds,N,userPtr);
-          setNodeChildren(node,childptrs,N,userPtr);
-          return std::make_pair(node,bounds);
+          return updateBuildNode(node,(BuildNode**)children,N,setNodeChildren,userPtr);
         },
         
-        /* lambda function that creates BVH leaves */
-        [&]( const range<unsigned>& current, FastAllocator::ThreadLocal* alloc) -> std::pair<void*,BBox3fa>
+        /* lambda function that creates BVH leaves, primitives get stored in morton order */
+        [&]( const range<unsigned>& current, FastAllocator::ThreadLocal* alloc) -> BuildNode*
         {
-          const size_t id = morton_src[current.begin()].index;
-          const BBox3fa bounds = prims[id].bounds(); 
-          void* node = createLeaf((RTCThreadLocalAllocator)alloc,prims_i+current.begin(),current.size(),userPtr);
-          return std::make_pair(node,bounds);
+          BBox3fa bounds = empty;
+          for (size_t i=current.begin(); i<current.end(); i++) {
+            morton_prims[i] = prims[morton_src[i].index];
+            bounds.extend(morton_prims[i].bounds());
+          }
+          BuildNode* node = createBuildLeaf(alloc,current.begin(),current.size(),bounds);
+          if (createLeaf) node->user = createLeaf((RTCThreadLocalAllocator)alloc,(RTCBuildPrimitive*)&morton_prims[current.begin()],current.size(),userPtr);
+          return node;
         },
         
         /* lambda that calculates the bounds for some primitive */
@@ -143,20 +284,26 @@ namespace embree
         morton_src.data(),morton_tmp.data(),numPrimitives,
         settings);
 
+      /* leaves reference the primitives in morton order */
+      parallel_for ( size_t(0), numPrimitives, [&](const range<size_t>& r) {
+          for (size_t i=r.begin(); i<r.end(); i++)
+            prims[i] = morton_prims[i];
+        });
+
       bvh->allocator.cleanup();
-      return root.first;
+      return root;
     }
 
-    void* rtcBuildBVHBinnedSAH(BVH* bvh,
-                               const RTCBuildSettings& settings,
-                               RTCBuildPrimitive* prims,
-                               size_t numPrimitives,
-                               RTCCreateNodeFunc createNode,
-                               RTCSetNodeChildrenFunc setNodeChildren,
-                               RTCSetNodeBoundsFunc setNodeBounds,
-                               RTCCreateLeafFunc createLeaf,
-                               RTCBuildProgressFunc buildProgress,
-                               void* userPtr)
+    BuildNode* rtcBuildBVHBinnedSAH(BVH* bvh,
+                                    const RTCBuildSettings& settings,
+                                    RTCBuildPrimitive* prims,
+                                    size_t numPrimitives,
+                                    RTCCreateNodeFunc createNode,
+                                    RTCSetNodeChildrenFunc setNodeChildren,
+                                    RTCSetNodeBoundsFunc setNodeBounds,
+                                    RTCCreateLeafFunc createLeaf,
+                                    RTCBuildProgressFunc buildProgress,
+                                    void* userPtr)
     {
       /* calculate priminfo */
       auto computeBounds = [&](const range<size_t>& r) -> CentGeomBBox3fa
@@ -172,7 +319,7 @@ namespace embree
       const PrimInfo pinfo(0,numPrimitives,bounds.geomBounds,bounds.centBounds);
       
       /* build BVH */
-      void* root = BVHBuilderBinnedSAH::build<void*>(
+      BuildNode* root = BVHBuilderBinnedSAH::build<BuildNode*>(
         
         /* thread local allocator for fast allocations */
         [&] () -> FastAllocator::ThreadLocal* { 
@@ -180,24 +327,28 @@ namespace embree
         },
 
         /* lambda function that creates BVH nodes */
-        [&](BVHBuilderBinnedSAH::BuildRecord* children, const size_t N, FastAllocator::ThreadLocal* alloc) -> void*
+        [&](BVHBuilderBinnedSAH::BuildRecord* children, const size_t N, FastAllocator::ThreadLocal* alloc) -> BuildNode*
         {
-          void* node = createNode((RTCThreadLocalAllocator)alloc,N,userPtr);
-          const RTCBounds* cbounds[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
-          for (size_t i=0; i<N; i++) cbounds[i] = (const RTCBounds*) &children[i].prims.geomBounds;
-          setNodeBounds(node,cbounds,N,userPtr);
+          BuildNode* node = createBuildNode(alloc,N);
+          if (createNode) node->user = createNode((RTCThreadLocalAllocator)alloc,N,userPtr);
+          if (setNodeBounds) {
+            const RTCBounds* cbounds[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+            for (size_t i=0; i<N; i++) cbounds[i] = (const RTCBounds*) &children[i].prims.geomBounds;
+            setNodeBounds(node->user,cbounds,N,userPtr);
+          }
           return node;
         },
 
         /* lambda function that updates BVH nodes */
-        [&](const BVHBuilderBinnedSAH::BuildRecord& precord, const BVHBuilderBinnedSAH::BuildRecord* crecords, void* node, void** children, const size_t N) -> void* {
-          setNodeChildren(node,children,N,userPtr);
-          return node;
+        [&](const BVHBuilderBinnedSAH::BuildRecord& precord, const BVHBuilderBinnedSAH::BuildRecord* crecords, BuildNode* node, BuildNode** children, const size_t N) -> BuildNode* {
+          return updateBuildNode(node,children,N,setNodeChildren,userPtr);
         },
         
         /* lambda function that creates BVH leaves */
-        [&](const BVHBuilderBinnedSAH::BuildRecord& current, FastAllocator::ThreadLocal* alloc) -> void* {
-          return createLeaf((RTCThreadLocalAllocator)alloc,prims+current.prims.begin(),current.prims.size(),userPtr);
+        [&](const BVHBuilderBinnedSAH::BuildRecord& current, FastAllocator::ThreadLocal* alloc) -> BuildNode* {
+          BuildNode* node = createBuildLeaf(alloc,current.prims.begin(),current.prims.size(),current.prims.geomBounds);
+          if (createLeaf) node->user = createLeaf((RTCThreadLocalAllocator)alloc,prims+current.prims.begin(),current.prims.size(),userPtr);
+          return node;
         },
         
         /* progress monitor function */
@@ -211,17 +362,17 @@ namespace embree
       return root;
     }
 
-     void* rtcBuildBVHSpatialSAH(BVH* bvh,
-                                 const RTCBuildSettings& settings,
-                                 RTCBuildPrimitive* prims,
-                                 size_t numPrimitives,
-                                 RTCCreateNodeFunc createNode,
-                                 RTCSetNodeChildrenFunc setNodeChildren,
-                                 RTCSetNodeBoundsFunc setNodeBounds,
-                                 RTCCreateLeafFunc createLeaf,
-                                 RTCSplitPrimitiveFunc splitPrimitive,
-                                 RTCBuildProgressFunc buildProgress,
-                                 void* userPtr)
+    BuildNode* rtcBuildBVHSpatialSAH(BVH* bvh,
+                                     const RTCBuildSettings& settings,
+                                     RTCBuildPrimitive* prims,
+                                     size_t numPrimitives,
+                                     RTCCreateNodeFunc createNode,
+                                     RTCSetNodeChildrenFunc setNodeChildren,
+                                     RTCSetNodeBoundsFunc setNodeBounds,
+                                     RTCCreateLeafFunc createLeaf,
+                                     RTCSplitPrimitiveFunc splitPrimitive,
+                                     RTCBuildProgressFunc buildProgress,
+                                     void* userPtr)
     {
       /* calculate priminfo */
       auto computeBounds = [&](const range<size_t>& r) -> CentGeomBBox3fa
@@ -263,7 +414,7 @@ namespace embree
       };
 
       /* build BVH */
-      void* root = BVHBuilderBinnedFastSpatialSAH::build<void*>(
+      BuildNode* root = BVHBuilderBinnedFastSpatialSAH::build<BuildNode*>(
         
         /* thread local allocator for fast allocations */
         [&] () -> FastAllocator::ThreadLocal* { 
@@ -271,24 +422,28 @@ namespace embree
         },
 
         /* lambda function that creates BVH nodes */
-        [&] (BVHBuilderBinnedFastSpatialSAH::BuildRecord* children, const size_t N, FastAllocator::ThreadLocal* alloc) -> void*
+        [&] (BVHBuilderBinnedFastSpatialSAH::BuildRecord* children, const size_t N, FastAllocator::ThreadLocal* alloc) -> BuildNode*
         {
-          void* node = createNode((RTCThreadLocalAllocator)alloc,N,userPtr);
-          const RTCBounds* cbounds[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
-          for (size_t i=0; i<N; i++) cbounds[i] = (const RTCBounds*) &children[i].prims.geomBounds;
-          setNodeBounds(node,cbounds,N,userPtr);
+          BuildNode* node = createBuildNode(alloc,N);
+          if (createNode) node->user = createNode((RTCThreadLocalAllocator)alloc,N,userPtr);
+          if (setNodeBounds) {
+            const RTCBounds* cbounds[GeneralBVHBuilder::MAX_BRANCHING_FACTOR];
+            for (size_t i=0; i<N; i++) cbounds[i] = (const RTCBounds*) &children[i].prims.geomBounds;
+            setNodeBounds(node->user,cbounds,N,userPtr);
+          }
           return node;
         },
 
         /* lambda function that updates BVH nodes */
-        [&] (const BVHBuilderBinnedFastSpatialSAH::BuildRecord& precord, const BVHBuilderBinnedFastSpatialSAH::BuildRecord* crecords, void* node, void** children, const size_t N) -> void* {
-          setNodeChildren(node,children,N,userPtr);
-          return node;
+        [&] (const BVHBuilderBinnedFastSpatialSAH::BuildRecord& precord, const BVHBuilderBinnedFastSpatialSAH::BuildRecord* crecords, BuildNode* node, BuildNode** children, const size_t N) -> BuildNode* {
+          return updateBuildNode(node,children,N,setNodeChildren,userPtr);
         },
         
         /* lambda function that creates BVH leaves */
-        [&] (const BVHBuilderBinnedFastSpatialSAH::BuildRecord& current, FastAllocator::ThreadLocal* alloc) -> void* {
-          return createLeaf((RTCThreadLocalAllocator)alloc,prims+current.prims.begin(),current.prims.size(),userPtr);
+        [&] (const BVHBuilderBinnedFastSpatialSAH::BuildRecord& current, FastAllocator::ThreadLocal* alloc) -> BuildNode* {
+          BuildNode* node = createBuildLeaf(alloc,current.prims.begin(),current.prims.size(),current.prims.geomBounds);
+          if (createLeaf) node->user = createLeaf((RTCThreadLocalAllocator)alloc,prims+current.prims.begin(),current.prims.size(),userPtr);
+          return node;
         },
         
         /* returns the splitter */
@@ -309,6 +464,46 @@ namespace embree
       return root;
     }
 
+    /*! builds the BVH with the builder selected by the quality level, node callbacks are optional */
+    BuildNode* rtcBuildBVHInternal(BVH* bvh,
+                                   const RTCBuildSettings& settings,
+                                   RTCBuildPrimitive* prims,
+                                   size_t numPrimitives,
+                                   RTCCreateNodeFunc createNode,
+                                   RTCSetNodeChildrenFunc setNodeChildren,
+                                   RTCSetNodeBoundsFunc setNodeBounds,
+                                   RTCCreateLeafFunc createLeaf,
+                                   RTCSplitPrimitiveFunc splitPrimitive,
+                                   RTCBuildProgressFunc buildProgress,
+                                   void* userPtr)
+    {
+      /* if we made this BVH static, we can not re-build it anymore  */
+      if (bvh->isStatic)
+        throw_RTCError(RTC_INVALID_OPERATION,"static BVH cannot get rebuild");
+
+      /* initialize the allocator */
+      bvh->root = nullptr;
+      bvh->compact.clear();
+      bvh->allocator.init_estimate(numPrimitives*sizeof(BBox3fa));
+      bvh->allocator.reset();
+
+      /* switch between differnet builders based on quality level */
+      if (settings.quality == RTC_BUILD_QUALITY_LOW)
+        bvh->root = rtcBuildBVHMorton   (bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,buildProgress,userPtr);
+      else if (settings.quality == RTC_BUILD_QUALITY_NORMAL)
+        bvh->root = rtcBuildBVHBinnedSAH(bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,buildProgress,userPtr);
+      else if (settings.quality == RTC_BUILD_QUALITY_HIGH) {
+        if (splitPrimitive == nullptr || settings.extraSpace == 0)
+          bvh->root = rtcBuildBVHBinnedSAH(bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,buildProgress,userPtr);
+        else
+          bvh->root = rtcBuildBVHSpatialSAH(bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,splitPrimitive,buildProgress,userPtr);  
+      }
+      else
+        throw_RTCError(RTC_INVALID_OPERATION,"invalid build quality");
+
+      return bvh->root;
+    }
+
     RTCORE_API void* rtcBuildBVH(RTCBVH hbvh,
                                  const RTCBuildSettings& settings,
                                  RTCBuildPrimitive* prims,
@@ -330,32 +525,59 @@ namespace embree
       RTCORE_VERIFY_HANDLE(setNodeBounds);
       RTCORE_VERIFY_HANDLE(createLeaf);
 
-      /* if we made this BVH static, we can not re-build it anymore  */
-      if (bvh->isStatic)
-        throw_RTCError(RTC_INVALID_OPERATION,"static BVH cannot get rebuild");
+      BuildNode* root = rtcBuildBVHInternal(bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,splitPrimitive,buildProgress,userPtr);
+      return root->user;
 
-      /* initialize the allocator */
-      bvh->allocator.init_estimate(numPrimitives*sizeof(BBox3fa));
-      bvh->allocator.reset();
+      RTCORE_CATCH_END(bvh->device);
+      return nullptr;
+    }
 
-      /* switch between differnet builders based on quality level */
-      if (settings.quality == RTC_BUILD_QUALITY_LOW)
-        return rtcBuildBVHMorton   (bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,buildProgress,userPtr);
-      else if (settings.quality == RTC_BUILD_QUALITY_NORMAL)
-        return rtcBuildBVHBinnedSAH(bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,buildProgress,userPtr);
-      else if (settings.quality == RTC_BUILD_QUALITY_HIGH) {
-        if (splitPrimitive == nullptr || settings.extraSpace == 0)
-          return rtcBuildBVHBinnedSAH(bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,buildProgress,userPtr);
-        else
-          return rtcBuildBVHSpatialSAH(bvh,settings,prims,numPrimitives,createNode,setNodeChildren,setNodeBounds,createLeaf,splitPrimitive,buildProgress,userPtr);  
-      }
-      else
-        throw_RTCError(RTC_INVALID_OPERATION,"invalid build quality");
+    RTCORE_API const RTCCompactNode* rtcBuildBVHCompact(RTCBVH hbvh,
+                                                        const RTCBuildSettings& settings,
+                                                        RTCBuildPrimitive* prims,
+                                                        size_t numPrimitives,
+                                                        RTCSplitPrimitiveFunc splitPrimitive,
+                                                        RTCBuildProgressFunc buildProgress,
+                                                        void* userPtr,
+                                                        size_t* numNodes)
+    {
+      BVH* bvh = (BVH*) hbvh;
+      RTCORE_CATCH_BEGIN;
+      RTCORE_TRACE(rtcBuildBVHCompact);
+      RTCORE_VERIFY_HANDLE(hbvh);
+
+      /* build hierarchy without invoking any node callbacks */
+      BuildNode* root = rtcBuildBVHInternal(bvh,settings,prims,numPrimitives,nullptr,nullptr,nullptr,nullptr,splitPrimitive,buildProgress,userPtr);
+
+      /* store nodes with consecutive children in a single array */
+      bvh->compact.resize(root->numNodes);
+      flattenBuildNode(root,bvh->compact.data(),0,1);
+      if (numNodes) *numNodes = bvh->compact.size();
+      return bvh->compact.data();
 
       RTCORE_CATCH_END(bvh->device);
+      if (numNodes) *numNodes = 0;
       return nullptr;
     }
 
+    RTCORE_API void rtcRefitBVH(RTCBVH hbvh,
+                                const RTCBuildPrimitive* prims,
+                                RTCSetNodeBoundsFunc setNodeBounds,
+                                void* userPtr)
+    {
+      BVH* bvh = (BVH*) hbvh;
+      RTCORE_CATCH_BEGIN;
+      RTCORE_TRACE(rtcRefitBVH);
+      RTCORE_VERIFY_HANDLE(hbvh);
+      RTCORE_VERIFY_HANDLE(prims);
+
+      if (bvh->root == nullptr)
+        throw_RTCError(RTC_INVALID_OPERATION,"BVH has to get build before it can get refit");
+
+      refitBuildNode(bvh,bvh->root,(const PrimRef*)prims,setNodeBounds,userPtr);
+      RTCORE_CATCH_END(bvh->device);
+    }
+
     RTCORE_API void* rtcThreadLocalAlloc(RTCThreadLocalAllocator localAllocator, size_t bytes, size_t align)
     {
       RTCORE_CATCH_BEGIN;
@@ -375,6 +597,7 @@ namespace embree
       bvh->allocator.shrink();
       bvh->morton_src.clear();
       bvh->morton_tmp.clear();
+      bvh->morton_prims.clear();
       bvh->isStatic = true;
       RTCORE_CATCH_END(bvh->device);
     }
@@ -128,6 +128,14 @@ namespace embree
     return rtcCommitThread(scene,threadID,numThreads);
   }
 
+  extern "C" void ispcSetCommitPriority (RTCScene scene, int priority) {
+    return rtcSetCommitPriority(scene,priority);
+  }
+
+  extern "C" void ispcCancelCommit (RTCScene scene) {
+    return rtcCancelCommit(scene);
+  }
+
   extern "C" void ispcGetBounds(RTCScene scene, RTCBounds& bounds_o) {
     rtcGetBounds(scene,bounds_o);
   }
@@ -244,6 +252,10 @@ namespace embree
     return rtcNewLineSegments(scene,flags,numSegments,numVertices,numTimeSteps);
   }
 
+  extern "C" unsigned ispcNewRoundLineSegments (RTCScene scene, RTCGeometryFlags flags, size_t numSegments, size_t numVertices, size_t numTimeSteps) {
+    return rtcNewRoundLineSegments(scene,flags,numSegments,numVertices,numTimeSteps);
+  }
+
   extern "C" unsigned ispcNewHairGeometry (RTCScene scene, RTCGeometryFlags flags, size_t numCurves, size_t numVertices, size_t numTimeSteps) {
     return rtcNewHairGeometry(scene,flags,numCurves,numVertices,numTimeSteps);
   }
@@ -309,6 +321,10 @@ namespace embree
   extern "C" void ispcSetTessellationRate (RTCScene hscene, unsigned geomID, float tessellationRate) {
     rtcSetTessellationRate(hscene,geomID,tessellationRate);
   }
+
+  extern "C" void ispcSetTessellationView (RTCScene hscene, unsigned geomID, const RTCTessellationView* view) {
+    rtcSetTessellationView(hscene,geomID,view);
+  }
     
   extern "C" void ispcSetUserData (RTCScene hscene, unsigned geomID, void* ptr) 
   {
@@ -608,6 +624,17 @@ namespace embree
     ((Scene*)scene)->get_locked(geomID)->setDisplacementFunction2((RTCDisplacementFunc2)func,bounds);
     RTCORE_CATCH_END(scene->device);
   }
+
+  extern "C" void ispcSetDisplacementFunctionN (RTCScene hscene, unsigned int geomID, void* func, RTCBounds* bounds)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTCORE_CATCH_BEGIN;
+    RTCORE_TRACE(rtcSetDisplacementFunctionN);
+    RTCORE_VERIFY_HANDLE(scene);
+    RTCORE_VERIFY_GEOMID(geomID);
+    ((Scene*)scene)->get_locked(geomID)->setDisplacementFunctionN((RTCDisplacementFuncN)func,bounds);
+    RTCORE_CATCH_END(scene->device);
+  }
   
   extern "C" void ispcInterpolateN(RTCScene scene, unsigned int geomID, 
                                    const void* valid, const unsigned int* primIDs, const float* u, const float* v, size_t numUVs, 
@@ -42,6 +42,7 @@ namespace embree
       needSubdivIndices(false), needSubdivVertices(false),
       is_build(false), modified(true),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0), 
+      commit_priority(0), commit_cancelled(false),
       numIntersectionFilters1(0), numIntersectionFilters4(0), numIntersectionFilters8(0), numIntersectionFilters16(0), numIntersectionFiltersN(0)
   {
 #if defined(TASKING_INTERNAL) 
@@ -129,18 +130,18 @@ namespace embree
         case /*0b10*/ 2: 
 #if defined (__TARGET_AVX__)
           if (device->hasISA(AVX)) 
-            accels.add(device->bvh8_factory->BVH8Triangle4i(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::FAST  )); 
+            accels.add(device->bvh8_factory->BVH8TriangleMeshlet(this,BVH8Factory::IntersectVariant::FAST  )); 
           else
 #endif
-            accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST  )); 
+            accels.add(device->bvh4_factory->BVH4TriangleMeshlet(this,BVH4Factory::IntersectVariant::FAST  )); 
           break;
         case /*0b11*/ 3: 
 #if defined (__TARGET_AVX__)
           if (device->hasISA(AVX)) 
-            accels.add(device->bvh8_factory->BVH8Triangle4i(this,BVH8Factory::BuildVariant::STATIC,BVH8Factory::IntersectVariant::ROBUST)); 
+            accels.add(device->bvh8_factory->BVH8TriangleMeshlet(this,BVH8Factory::IntersectVariant::ROBUST)); 
           else
 #endif
-            accels.add(device->bvh4_factory->BVH4Triangle4i(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST)); 
+            accels.add(device->bvh4_factory->BVH4TriangleMeshlet(this,BVH4Factory::IntersectVariant::ROBUST)); 
           break;
         }
       }
@@ -174,11 +175,13 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4v")      accels.add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels.add(device->bvh4_factory->BVH4Triangle4i(this));
     else if (device->tri_accel == "qbvh4.triangle4i")     accels.add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
+    else if (device->tri_accel == "bvh4.trianglemeshlet") accels.add(device->bvh4_factory->BVH4TriangleMeshlet(this));
 
 #if defined (__TARGET_AVX__)
     else if (device->tri_accel == "bvh8.triangle4")       accels.add(device->bvh8_factory->BVH8Triangle4 (this));
     else if (device->tri_accel == "bvh8.triangle4i")      accels.add(device->bvh8_factory->BVH8Triangle4i(this));
     else if (device->tri_accel == "qbvh8.triangle4i")     accels.add(device->bvh8_factory->BVH8QuantizedTriangle4i(this));
+    else if (device->tri_accel == "bvh8.trianglemeshlet") accels.add(device->bvh8_factory->BVH8TriangleMeshlet(this));
 #endif
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown triangle acceleration structure "+device->tri_accel);
 #endif
@@ -260,7 +263,12 @@ namespace embree
             accels.add(device->bvh4_factory->BVH4Quad4v(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST));
           break;
 
-        case /*0b10*/ 2: accels.add(device->bvh4_factory->BVH4Quad4i(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST)); break;
+        case /*0b10*/ 2: 
+          if (isHighQuality())
+            accels.add(device->bvh4_factory->BVH4Quad4i(this,BVH4Factory::BuildVariant::HIGH_QUALITY,BVH4Factory::IntersectVariant::FAST)); 
+          else
+            accels.add(device->bvh4_factory->BVH4Quad4i(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::FAST)); 
+          break;
         case /*0b11*/ 3: accels.add(device->bvh4_factory->BVH4Quad4i(this,BVH4Factory::BuildVariant::STATIC,BVH4Factory::IntersectVariant::ROBUST)); break;
         }
       }
@@ -383,9 +391,11 @@ namespace embree
     else if (device->hair_accel == "bvh4.bezier1i"    ) accels.add(device->bvh4_factory->BVH4Bezier1i(this));
     else if (device->hair_accel == "bvh4obb.bezier1v" ) accels.add(device->bvh4_factory->BVH4OBBBezier1v(this));
     else if (device->hair_accel == "bvh4obb.bezier1i" ) accels.add(device->bvh4_factory->BVH4OBBBezier1i(this));
+    else if (device->hair_accel == "bvh4obb.bezier4q" ) accels.add(device->bvh4_factory->BVH4OBBBezier4q(this));
 #if defined (__TARGET_AVX__)
     else if (device->hair_accel == "bvh8obb.bezier1v" ) accels.add(device->bvh8_factory->BVH8OBBBezier1v(this));
     else if (device->hair_accel == "bvh8obb.bezier1i" ) accels.add(device->bvh8_factory->BVH8OBBBezier1i(this));
+    else if (device->hair_accel == "bvh8obb.bezier4q" ) accels.add(device->bvh8_factory->BVH8OBBBezier4q(this));
 #endif
     else throw_RTCError(RTC_INVALID_ARGUMENT,"unknown hair acceleration structure "+device->hair_accel);
 #endif
@@ -424,10 +434,20 @@ namespace embree
       {
 #if defined (__TARGET_AVX__)
         if (device->hasISA(AVX) && !isCompact())
-          accels.add(device->bvh8_factory->BVH8Line4i(this));
+        {
+          if (isHighQuality())
+            accels.add(device->bvh8_factory->BVH8Line4i(this,BVH8Factory::BuildVariant::HIGH_QUALITY));
+          else
+            accels.add(device->bvh8_factory->BVH8Line4i(this,BVH8Factory::BuildVariant::STATIC));
+        }
         else
 #endif
-          accels.add(device->bvh4_factory->BVH4Line4i(this,BVH4Factory::BuildVariant::STATIC));
+        {
+          if (isHighQuality())
+            accels.add(device->bvh4_factory->BVH4Line4i(this,BVH4Factory::BuildVariant::HIGH_QUALITY));
+          else
+            accels.add(device->bvh4_factory->BVH4Line4i(this,BVH4Factory::BuildVariant::STATIC));
+        }
       }
       else
       {
@@ -652,7 +672,7 @@ namespace embree
 #endif
 
 #if defined(EMBREE_GEOMETRY_LINES)
-  unsigned Scene::newLineSegments (RTCGeometryFlags gflags, size_t numSegments, size_t numVertices, size_t numTimeSteps)
+  unsigned Scene::newLineSegments (LineSegments::SubType subtype, RTCGeometryFlags gflags, size_t numSegments, size_t numVertices, size_t numTimeSteps)
   {
     if (isStatic() && (gflags != RTC_GEOMETRY_STATIC)) {
       throw_RTCError(RTC_INVALID_OPERATION,"static scenes can only contain static geometries");
@@ -664,7 +684,7 @@ namespace embree
       return -1;
     }
 
-    return add(new LineSegments(this,gflags,numSegments,numVertices,numTimeSteps));
+    return add(new LineSegments(this,subtype,gflags,numSegments,numVertices,numTimeSteps));
   }
 #endif
 
@@ -719,7 +739,9 @@ namespace embree
 
   void Scene::commit_task ()
   {
+    TraceScope trace("commit");
     progress_monitor_counter = 0;
+    commit_cancelled = false;
 
     /* call preCommit function of each geometry */
     parallel_for(geometries.size(), [&] ( const size_t i ) {
@@ -769,6 +791,7 @@ namespace embree
       if (scheduler == null) {
         buildLock.lock();
         this->scheduler = scheduler = new TaskScheduler;
+        scheduler->setPriority(commit_priority);
       }
     }
 
@@ -801,8 +824,20 @@ namespace embree
     catch (...) {
       accels.clear();
       updateInterface();
+      {
+        Lock<MutexSys> lock(schedulerMutex);
+        this->scheduler = nullptr;
+      }
+      if (scheduler->isCancelled())
+        throw_RTCError(RTC_CANCELLED,"commit got cancelled");
       throw;
     }
+
+    if (device->verbosity(2)) {
+      TaskScheduler::IdleStatistics stats = scheduler->idleStatistics();
+      std::cout << "worker threads: work = " << 1000.0*stats.workTime << " ms, spin = " << 1000.0*stats.spinTime << " ms, "
+                << "parked = " << 1000.0*stats.parkTime << " ms (" << stats.numParks << " times)" << std::endl;
+    }
   }
 
 #endif
@@ -871,7 +906,10 @@ namespace embree
 #else
       tbb::task_group_context ctx( tbb::task_group_context::isolated, tbb::task_group_context::default_traits | tbb::task_group_context::fp_settings );
 #endif
-      //ctx.set_priority(tbb::priority_high);
+#if __TBB_TASK_PRIORITY
+      if      (commit_priority > 0) ctx.set_priority(tbb::priority_high);
+      else if (commit_priority < 0) ctx.set_priority(tbb::priority_low);
+#endif
 
 #if USE_TASK_ARENA
       device->arena->execute([&]{
@@ -917,8 +955,24 @@ namespace embree
     mutex.unlock();
   }
 
+  void Scene::setCommitPriority(int priority) {
+    commit_priority = priority;
+  }
+
+  void Scene::cancelCommit()
+  {
+    commit_cancelled = true;
+#if defined(TASKING_INTERNAL)
+    Lock<MutexSys> lock(schedulerMutex);
+    if (scheduler) scheduler->cancel();
+#endif
+  }
+
   void Scene::progressMonitor(double dn)
   {
+    if (commit_cancelled)
+      throw_RTCError(RTC_CANCELLED,"commit got cancelled");
+
     if (progress_monitor_function) {
       size_t n = size_t(dn) + progress_monitor_counter.fetch_add(size_t(dn));
       if (!progress_monitor_function(progress_monitor_ptr, n / (double(numPrimitives())))) {
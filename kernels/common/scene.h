@@ -147,7 +147,7 @@ namespace embree
     unsigned int newCurves (NativeCurves::SubType subtype, NativeCurves::Basis basis, RTCGeometryFlags flags, size_t maxCurves, size_t maxVertices, size_t numTimeSteps);
 
     /*! Creates a new collection of line segments. */
-    unsigned int newLineSegments (RTCGeometryFlags flags, size_t maxSegments, size_t maxVertices, size_t numTimeSteps);
+    unsigned int newLineSegments (LineSegments::SubType subtype, RTCGeometryFlags flags, size_t maxSegments, size_t maxVertices, size_t numTimeSteps);
 
     /*! Creates a new subdivision mesh. */
     unsigned int newSubdivisionMesh (RTCGeometryFlags flags, size_t numFaces, size_t numEdges, size_t numVertices, size_t numEdgeCreases, size_t numVertexCreases, size_t numHoles, size_t numTimeSteps);
@@ -288,6 +288,12 @@ namespace embree
     void progressMonitor(double nprims);
     void setProgressMonitorFunction(RTCProgressMonitorFunc func, void* ptr);
 
+  public:
+    int commit_priority;                   //!< priority of the commits of this scene
+    std::atomic<bool> commit_cancelled;    //!< set when the current commit should get cancelled
+    void setCommitPriority(int priority);
+    void cancelCommit();
+
   public:
     struct GeometryCounts 
     {
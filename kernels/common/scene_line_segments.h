@@ -28,10 +28,13 @@ namespace embree
     /*! type of this geometry */
     static const Geometry::Type geom_type = Geometry::LINE_SEGMENTS;
 
+    /*! this geometry represents ray facing ribbons or round capped cones */
+    enum SubType { FLAT = 0, ROUND = 1 };
+
   public:
 
     /*! line segments construction */
-    LineSegments (Scene* parent, RTCGeometryFlags flags, size_t numPrimitives, size_t numVertices, size_t numTimeSteps);
+    LineSegments (Scene* parent, SubType subtype, RTCGeometryFlags flags, size_t numPrimitives, size_t numVertices, size_t numTimeSteps);
 
   public:
     void enabling();
@@ -176,5 +179,6 @@ namespace embree
     BufferRefT<Vec3fa> vertices0;                     //!< fast access to first vertex buffer
     vector<APIBuffer<Vec3fa>> vertices;               //!< vertex array for each timestep
     vector<APIBuffer<char>> userbuffers;              //!< user buffers
+    SubType subtype;                                  //!< flat or round line segments
   };
 }
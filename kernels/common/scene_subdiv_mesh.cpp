@@ -22,6 +22,7 @@
 #include "../../common/algorithms/parallel_sort.h"
 #include "../../common/algorithms/parallel_prefix_sum.h"
 #include "../../common/algorithms/parallel_for.h"
+#include "../../common/algorithms/parallel_reduce.h"
 
 namespace embree
 {
@@ -30,7 +31,9 @@ namespace embree
     : Geometry(parent,SUBDIV_MESH,numFaces,numTimeSteps,flags), 
       displFunc(nullptr),
       displFunc2(nullptr),
+      displFuncN(nullptr),
       displBounds(empty),
+      gridCacheID(SharedGridCache::newMeshID()),
       tessellationRate(2.0f),
       numHalfEdges(0),
       faceStartEdge(parent->device),
@@ -52,6 +55,7 @@ namespace embree
 
     topology.resize(1);
     topology[0] = Topology(this,numEdges);
+    view.enabled = false;
     enabling();
   }
 
@@ -313,6 +317,7 @@ namespace embree
     this->displFunc   = func;
     if (bounds) this->displBounds = *(BBox3fa*)bounds; 
     else        this->displBounds = empty;
+    this->gridCacheID = SharedGridCache::newMeshID(); // invalidates cached displaced grids
   }
 
   void SubdivMesh::setDisplacementFunction2 (RTCDisplacementFunc2 func, RTCBounds* bounds) 
@@ -323,6 +328,18 @@ namespace embree
     this->displFunc2   = func;
     if (bounds) this->displBounds = *(BBox3fa*)bounds; 
     else        this->displBounds = empty;
+    this->gridCacheID = SharedGridCache::newMeshID(); // invalidates cached displaced grids
+  }
+
+  void SubdivMesh::setDisplacementFunctionN (RTCDisplacementFuncN func, RTCBounds* bounds) 
+  {
+    if (parent->isStatic() && parent->isBuild())
+      throw_RTCError(RTC_INVALID_OPERATION,"static scenes cannot get modified");
+
+    this->displFuncN   = func;
+    if (bounds) this->displBounds = *(BBox3fa*)bounds; 
+    else        this->displBounds = empty;
+    this->gridCacheID = SharedGridCache::newMeshID(); // invalidates cached displaced grids
   }
 
   void SubdivMesh::setTessellationRate(float N)
@@ -334,6 +351,51 @@ namespace embree
     levels.setModified(true);
   }
 
+  void SubdivMesh::setTessellationView(const RTCTessellationView* v)
+  {
+    if (parent->isStatic() && parent->isBuild()) 
+      throw_RTCError(RTC_INVALID_OPERATION,"static geometries cannot get modified");
+
+    view.enabled = v != nullptr;
+    if (v)
+    {
+      if (v->height == 0 || v->pixelsPerEdge <= 0.0f || v->fovy <= 0.0f || v->fovy >= 180.0f)
+        throw_RTCError(RTC_INVALID_ARGUMENT,"invalid tessellation view");
+
+      const float tanY = tan(0.5f*deg2rad(v->fovy));
+      const float tanX = tanY*max(v->aspect,0.0f);
+      view.P = Vec3fa(v->camera_x,v->camera_y,v->camera_z);
+      view.dir = normalize(Vec3fa(v->dir_x,v->dir_y,v->dir_z));
+      view.scale = float(v->height)/(2.0f*tanY*v->pixelsPerEdge);
+      view.cullAngle = atan(sqrt(tanX*tanX+tanY*tanY));
+      view.culledLevel = v->culledLevel;
+    }
+    levels.setModified(true);
+  }
+
+  float SubdivMesh::getViewEdgeLevel(const unsigned v0, const unsigned v1) const
+  {
+    if (unlikely(v0 >= numVertices() || v1 >= numVertices()))
+      return 1.0f;
+
+    /* the level depends only on the bounding sphere of the edge, thus both half edges get the same level */
+    const Vec3fa p0 = vertices[0][v0];
+    const Vec3fa p1 = vertices[0][v1];
+    const Vec3fa c = 0.5f*(p0+p1);
+    const float r = 0.5f*length(p1-p0);
+    const Vec3fa d = c-view.P;
+    const float dist = length(d);
+
+    /* edges whose bounding sphere is outside the cone around the view frustum get culled */
+    if (view.culledLevel >= 0.0f && dist > r) 
+    {
+      const float angle = acos(clamp(dot(d,view.dir)/dist,-1.0f,1.0f)) - asin(r/dist);
+      if (angle > view.cullAngle)
+        return clamp(view.culledLevel,1.0f,4096.0f);
+    }
+    return clamp(2.0f*r*view.scale/max(dist,1E-6f),1.0f,4096.0f); // FIXME: do we want to limit edge level?
+  }
+
   void SubdivMesh::immutable () 
   {
     const bool freeVertices = !parent->needSubdivVertices;
@@ -399,6 +461,117 @@ namespace embree
     return true;
   }
 
+  void SubdivMesh::Topology::initHalfEdges(size_t f, KeyHalfEdge* keys)
+  {
+    const unsigned N = mesh->faceVertices[f];
+    const unsigned e = mesh->faceStartEdge[f];
+
+    for (unsigned de=0; de<N; de++)
+    {
+      HalfEdge* edge = &halfEdges[e+de];
+      int nextOfs = (de == (N-1)) ? -int(N-1) : +1;
+      int prevOfs = (de ==     0) ? +int(N-1) : -1;
+      
+      const unsigned int startVertex = vertexIndices[e+de];
+      const unsigned int endVertex = vertexIndices[e+de+nextOfs]; 
+      const uint64_t key = SubdivMesh::Edge(startVertex,endVertex);
+
+      /* we always have to use the geometry topology to lookup creases */
+      const unsigned int startVertex0 = mesh->topology[0].vertexIndices[e+de];
+      const unsigned int endVertex0 = mesh->topology[0].vertexIndices[e+de+nextOfs]; 
+      const uint64_t key0 = SubdivMesh::Edge(startVertex0,endVertex0);
+      
+      edge->vtx_index              = startVertex;
+      edge->next_half_edge_ofs     = nextOfs;
+      edge->prev_half_edge_ofs     = prevOfs;
+      edge->opposite_half_edge_ofs = 0;
+      edge->edge_crease_weight     = mesh->edgeCreaseMap.lookup(key0,0.0f);
+      edge->vertex_crease_weight   = mesh->vertexCreaseMap.lookup(startVertex0,0.0f);
+      edge->edge_level             = mesh->getEdgeLevel(e+de,startVertex0,endVertex0);
+      edge->patch_type             = HalfEdge::COMPLEX_PATCH; // type gets updated below
+      edge->vertex_type            = HalfEdge::REGULAR_VERTEX;
+
+      if (!keys) continue;
+      if (unlikely(mesh->holeSet.lookup(unsigned(f)))) 
+        keys[de] = SubdivMesh::KeyHalfEdge(std::numeric_limits<uint64_t>::max(),edge);
+      else
+        keys[de] = SubdivMesh::KeyHalfEdge(key,edge);
+    }
+  }
+
+  void SubdivMesh::Topology::linkHalfEdges(const KeyHalfEdge* edges, size_t N)
+  {
+    /* border edges are identified by not having an opposite edge set */
+    if (N == 1) {
+      edges[0].edge->edge_crease_weight = float(inf);
+    }
+
+    /* standard edge shared between two faces */
+    else if (N == 2)
+    {
+      /* create edge crease if winding order mismatches between neighboring patches */
+      if (edges[0].edge->next()->vtx_index != edges[1].edge->vtx_index)
+      {
+        edges[0].edge->edge_crease_weight = float(inf);
+        edges[1].edge->edge_crease_weight = float(inf);
+      }
+      /* otherwise mark edges as opposites of each other */
+      else {
+        edges[0].edge->setOpposite(edges[1].edge);
+        edges[1].edge->setOpposite(edges[0].edge);
+      }
+    }
+
+    /* non-manifold geometry is handled by keeping vertices fixed during subdivision */
+    else {
+      for (size_t i=0; i<N; i++) {
+        edges[i].edge->vertex_crease_weight = inf;
+        edges[i].edge->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
+        edges[i].edge->edge_crease_weight = inf;
+
+        edges[i].edge->next()->vertex_crease_weight = inf;
+        edges[i].edge->next()->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
+        edges[i].edge->next()->edge_crease_weight = inf;
+      }
+    }
+  }
+
+  void SubdivMesh::Topology::finalizeFace(size_t f)
+  {
+    HalfEdge* edge = &halfEdges[mesh->faceStartEdge[f]];
+
+    /* for vertex topology we also test if vertices are valid */
+    if (this == &mesh->topology[0])
+    {
+      /* calculate if face is valid */
+      for (size_t t=0; t<mesh->numTimeSteps; t++)
+        mesh->invalidFace(f,t) = !edge->valid(mesh->vertices[t]) || mesh->holeSet.lookup(unsigned(f));
+    }
+
+    /* pin some edges and vertices */
+    for (size_t i=0; i<mesh->faceVertices[f]; i++) 
+    {
+      /* pin corner vertices when requested by user */
+      if (subdiv_mode == RTC_SUBDIV_PIN_CORNERS && edge[i].isCorner())
+        edge[i].vertex_crease_weight = float(inf);
+      
+      /* pin all border vertices when requested by user */
+      else if (subdiv_mode == RTC_SUBDIV_PIN_BOUNDARY && edge[i].vertexHasBorder()) 
+        edge[i].vertex_crease_weight = float(inf);
+
+      /* pin all edges and vertices when requested by user */
+      else if (subdiv_mode == RTC_SUBDIV_PIN_ALL) {
+        edge[i].edge_crease_weight = float(inf);
+        edge[i].vertex_crease_weight = float(inf);
+      }
+    }
+
+    /* we have to calculate patch_type last! */
+    HalfEdge::PatchType patch_type = edge->patchType();
+    for (size_t i=0; i<mesh->faceVertices[f]; i++) 
+      edge[i].patch_type = patch_type;
+  }
+
   void SubdivMesh::Topology::calculateHalfEdges()
   {
     const size_t blockSize = 4096;
@@ -414,41 +587,7 @@ namespace embree
     parallel_for( size_t(0), numFaces, blockSize, [&](const range<size_t>& r) 
     {
       for (size_t f=r.begin(); f<r.end(); f++) 
-      {
-	const unsigned N = mesh->faceVertices[f];
-	const unsigned e = mesh->faceStartEdge[f];
-
-	for (unsigned de=0; de<N; de++)
-	{
-	  HalfEdge* edge = &halfEdges[e+de];
-          int nextOfs = (de == (N-1)) ? -int(N-1) : +1;
-          int prevOfs = (de ==     0) ? +int(N-1) : -1;
-	  
-	  const unsigned int startVertex = vertexIndices[e+de];
-          const unsigned int endVertex = vertexIndices[e+de+nextOfs]; 
-	  const uint64_t key = SubdivMesh::Edge(startVertex,endVertex);
-
-          /* we always have to use the geometry topology to lookup creases */
-          const unsigned int startVertex0 = mesh->topology[0].vertexIndices[e+de];
-          const unsigned int endVertex0 = mesh->topology[0].vertexIndices[e+de+nextOfs]; 
-	  const uint64_t key0 = SubdivMesh::Edge(startVertex0,endVertex0);
-	  
-	  edge->vtx_index              = startVertex;
-	  edge->next_half_edge_ofs     = nextOfs;
-	  edge->prev_half_edge_ofs     = prevOfs;
-	  edge->opposite_half_edge_ofs = 0;
-	  edge->edge_crease_weight     = mesh->edgeCreaseMap.lookup(key0,0.0f);
-	  edge->vertex_crease_weight   = mesh->vertexCreaseMap.lookup(startVertex0,0.0f);
-	  edge->edge_level             = mesh->getEdgeLevel(e+de);
-          edge->patch_type             = HalfEdge::COMPLEX_PATCH; // type gets updated below
-          edge->vertex_type            = HalfEdge::REGULAR_VERTEX;
-
-          if (unlikely(mesh->holeSet.lookup(unsigned(f)))) 
-	    halfEdges1[e+de] = SubdivMesh::KeyHalfEdge(std::numeric_limits<uint64_t>::max(),edge);
-	  else
-	    halfEdges1[e+de] = SubdivMesh::KeyHalfEdge(key,edge);
-	}
-      }
+        initHalfEdges(f,&halfEdges1[mesh->faceStartEdge[f]]);
     });
 
     /* sort half edges to find adjacent edges */
@@ -470,40 +609,7 @@ namespace embree
 	const uint64_t key = halfEdges1[e].key;
 	if (key == std::numeric_limits<uint64_t>::max()) break;
 	size_t N=1; while (e+N<numHalfEdges && halfEdges1[e+N].key == key) N++;
-
-        /* border edges are identified by not having an opposite edge set */
-	if (N == 1) {
-          halfEdges1[e].edge->edge_crease_weight = float(inf);
-	}
-
-        /* standard edge shared between two faces */
-        else if (N == 2)
-        {
-          /* create edge crease if winding order mismatches between neighboring patches */
-          if (halfEdges1[e+0].edge->next()->vtx_index != halfEdges1[e+1].edge->vtx_index)
-          {
-            halfEdges1[e+0].edge->edge_crease_weight = float(inf);
-            halfEdges1[e+1].edge->edge_crease_weight = float(inf);
-          }
-          /* otherwise mark edges as opposites of each other */
-          else {
-            halfEdges1[e+0].edge->setOpposite(halfEdges1[e+1].edge);
-            halfEdges1[e+1].edge->setOpposite(halfEdges1[e+0].edge);
-          }
-	}
-
-        /* non-manifold geometry is handled by keeping vertices fixed during subdivision */
-        else {
-	  for (size_t i=0; i<N; i++) {
-	    halfEdges1[e+i].edge->vertex_crease_weight = inf;
-            halfEdges1[e+i].edge->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
-            halfEdges1[e+i].edge->edge_crease_weight = inf;
-
-	    halfEdges1[e+i].edge->next()->vertex_crease_weight = inf;
-            halfEdges1[e+i].edge->next()->vertex_type = HalfEdge::NON_MANIFOLD_EDGE_VERTEX;
-            halfEdges1[e+i].edge->next()->edge_crease_weight = inf;
-	  }
-	}
+        linkHalfEdges(&halfEdges1[e],N);
 	e+=N;
       }
     });
@@ -511,42 +617,179 @@ namespace embree
     /* set subdivision mode and calculate patch types */
     parallel_for( size_t(0), numFaces, blockSize, [&](const range<size_t>& r) 
     {
+      for (size_t f=r.begin(); f<r.end(); f++) 
+        finalizeFace(f);
+    });
+  }
+
+  bool SubdivMesh::Topology::calculateHalfEdgesIncremental()
+  {
+    const size_t blockSize = 4096;
+    const size_t numFaces = mesh->numFaces();
+    const size_t numHalfEdges = mesh->numHalfEdges;
+
+    /* we need the sorted half edges of the previous calculation */
+    if (halfEdges1.size() != mesh->numEdges())
+      return false;
+
+    /* the half edges still store the vertex indices of the previous commit, thus we can detect modified faces */
+    std::vector<char> dirtyFace(numFaces);
+    const size_t numDirtyFaces = parallel_reduce( size_t(0), numFaces, blockSize, size_t(0), [&](const range<size_t>& r) -> size_t
+    {
+      size_t n = 0;
       for (size_t f=r.begin(); f<r.end(); f++) 
       {
-        HalfEdge* edge = &halfEdges[mesh->faceStartEdge[f]];
+        const unsigned N = mesh->faceVertices[f];
+        const unsigned e = mesh->faceStartEdge[f];
+        bool dirty = false;
+        for (unsigned de=0; de<N; de++)
+          dirty |= halfEdges[e+de].vtx_index != vertexIndices[e+de];
+        dirtyFace[f] = dirty;
+        n += dirty;
+      }
+      return n;
+    }, std::plus<size_t>());
 
-        /* for vertex topology we also test if vertices are valid */
-        if (this == &mesh->topology[0])
-        {
-          /* calculate if face is valid */
-          for (size_t t=0; t<mesh->numTimeSteps; t++)
-            mesh->invalidFace(f,t) = !edge->valid(mesh->vertices[t]) || mesh->holeSet.lookup(unsigned(f));
+    /* recalculating all half edges is faster when many faces changed */
+    if (numDirtyFaces > numFaces/8)
+      return false;
+
+    /* old and new vertices of modified faces */
+    std::vector<char> dirtyEdge(halfEdges.size());
+    std::vector<char> dirtyVertex;
+    auto markVertex = [&] (unsigned v) {
+      if (v >= dirtyVertex.size()) dirtyVertex.resize(v+1);
+      dirtyVertex[v] = true;
+    };
+    for (size_t f=0; f<numFaces; f++) 
+    {
+      if (!dirtyFace[f]) continue;
+      const unsigned e = mesh->faceStartEdge[f];
+      for (unsigned de=0; de<mesh->faceVertices[f]; de++) {
+        dirtyEdge[e+de] = true;
+        markVertex(halfEdges[e+de].vtx_index);
+        markVertex(vertexIndices[e+de]);
+      }
+    }
+
+    /* Only edges between two of these vertices change their adjacency,
+     * thus the half edges, creases, and patch types of all faces
+     * touching these vertices have to get recalculated. */
+    std::vector<char> affectedFace(numFaces);
+    parallel_for( size_t(0), numFaces, blockSize, [&](const range<size_t>& r) 
+    {
+      for (size_t f=r.begin(); f<r.end(); f++) 
+      {
+        const unsigned N = mesh->faceVertices[f];
+        const unsigned e = mesh->faceStartEdge[f];
+        bool affected = false;
+        for (unsigned de=0; de<N; de++) {
+          const unsigned v = vertexIndices[e+de];
+          affected |= v < dirtyVertex.size() && dirtyVertex[v];
         }
+        affectedFace[f] = affected;
+      }
+    });
+    std::vector<unsigned> affectedFaces;
+    for (size_t f=0; f<numFaces; f++) 
+      if (affectedFace[f]) affectedFaces.push_back(unsigned(f));
 
-        /* pin some edges and vertices */
-        for (size_t i=0; i<mesh->faceVertices[f]; i++) 
-        {
-          /* pin corner vertices when requested by user */
-          if (subdiv_mode == RTC_SUBDIV_PIN_CORNERS && edge[i].isCorner())
-            edge[i].vertex_crease_weight = float(inf);
-          
-          /* pin all border vertices when requested by user */
-          else if (subdiv_mode == RTC_SUBDIV_PIN_BOUNDARY && edge[i].vertexHasBorder()) 
-            edge[i].vertex_crease_weight = float(inf);
+    /* reinitialize all affected half edges and calculate new keys of modified faces */
+    std::vector<KeyHalfEdge> newKeys;
+    for (size_t i=0; i<affectedFaces.size(); i++)
+    {
+      const unsigned f = affectedFaces[i];
+      if (dirtyFace[f]) {
+        const size_t ofs = newKeys.size();
+        newKeys.resize(ofs+mesh->faceVertices[f]);
+        initHalfEdges(f,&newKeys[ofs]);
+      }
+      else
+        initHalfEdges(f,nullptr);
+    }
+    std::sort(newKeys.begin(),newKeys.end());
 
-          /* pin all edges and vertices when requested by user */
-          else if (subdiv_mode == RTC_SUBDIV_PIN_ALL) {
-            edge[i].edge_crease_weight = float(inf);
-            edge[i].vertex_crease_weight = float(inf);
-          }
+    /* merge new keys into sorted keys of unmodified faces */
+    const size_t numBlocks = (numHalfEdges+blockSize-1)/blockSize;
+    std::vector<size_t> blockOffset(numBlocks+1);
+    parallel_for( size_t(0), numBlocks, [&](const range<size_t>& r) 
+    {
+      for (size_t b=r.begin(); b<r.end(); b++) 
+      {
+        size_t n = 0;
+        for (size_t i=b*blockSize; i<min(numHalfEdges,(b+1)*blockSize); i++) 
+          n += !dirtyEdge[halfEdges1[i].edge-halfEdges.data()];
+        blockOffset[b+1] = n;
+      }
+    });
+    auto newKeysBegin = [&] (size_t b) -> size_t {
+      if (b == numBlocks) return newKeys.size();
+      return std::lower_bound(newKeys.begin(),newKeys.end(),halfEdges1[b*blockSize]) - newKeys.begin();
+    };
+    for (size_t b=0; b<numBlocks; b++) blockOffset[b+1] += blockOffset[b];
+    
+    halfEdges0.resize(halfEdges1.size());
+    parallel_for( size_t(0), numBlocks, [&](const range<size_t>& r) 
+    {
+      for (size_t b=r.begin(); b<r.end(); b++) 
+      {
+        size_t i = b*blockSize, iend = min(numHalfEdges,(b+1)*blockSize);
+        size_t j = newKeysBegin(b), jend = newKeysBegin(b+1);
+        size_t k = blockOffset[b]+j;
+        while (i<iend || j<jend)
+        {
+          if (i<iend && dirtyEdge[halfEdges1[i].edge-halfEdges.data()]) i++;
+          else if (j == jend || (i<iend && halfEdges1[i].key <= newKeys[j].key)) halfEdges0[k++] = halfEdges1[i++];
+          else halfEdges0[k++] = newKeys[j++];
         }
+      }
+    });
+    std::swap(halfEdges0,halfEdges1);
+
+    /* link all adjacent edges of affected half edges again */
+    std::vector<uint64_t> keys;
+    for (size_t i=0; i<affectedFaces.size(); i++)
+    {
+      const unsigned f = affectedFaces[i];
+      if (mesh->holeSet.lookup(f)) continue;
+      const HalfEdge* edge = &halfEdges[mesh->faceStartEdge[f]];
+      for (unsigned de=0; de<mesh->faceVertices[f]; de++)
+        keys.push_back(edge[de].getEdge());
+    }
+    std::sort(keys.begin(),keys.end());
+    keys.erase(std::unique(keys.begin(),keys.end()),keys.end());
 
-        /* we have to calculate patch_type last! */
-        HalfEdge::PatchType patch_type = edge->patchType();
-        for (size_t i=0; i<mesh->faceVertices[f]; i++) 
-          edge[i].patch_type = patch_type;
+    parallel_for( size_t(0), keys.size(), size_t(256), [&](const range<size_t>& r) 
+    {
+      for (size_t i=r.begin(); i<r.end(); i++) 
+      {
+        const KeyHalfEdge key(keys[i],nullptr);
+        const auto begin = std::lower_bound(halfEdges1.begin(),halfEdges1.begin()+numHalfEdges,key);
+        const auto end   = std::upper_bound(begin,halfEdges1.begin()+numHalfEdges,key);
+        linkHalfEdges(&*begin,end-begin);
       }
     });
+
+    /* set subdivision mode and calculate patch types */
+    parallel_for( size_t(0), affectedFaces.size(), size_t(256), [&](const range<size_t>& r) 
+    {
+      for (size_t i=r.begin(); i<r.end(); i++) 
+        finalizeFace(affectedFaces[i]);
+    });
+
+    /* validity of unaffected faces only changes with the vertices */
+    bool verticesModified = false;
+    for (auto& buffer : mesh->vertices) verticesModified |= buffer.isModified();
+    if (this == &mesh->topology[0] && verticesModified)
+    {
+      parallel_for( size_t(0), numFaces, blockSize, [&](const range<size_t>& r) 
+      {
+        for (size_t f=r.begin(); f<r.end(); f++) 
+          for (size_t t=0; t<mesh->numTimeSteps; t++)
+            mesh->invalidFace(f,t) = !getHalfEdge(f)->valid(mesh->vertices[t]) || mesh->holeSet.lookup(unsigned(f));
+      });
+    }
+    return true;
   }
 
   void SubdivMesh::Topology::updateHalfEdges()
@@ -571,7 +814,7 @@ namespace embree
 	HalfEdge& edge = halfEdges[i];
 
 	if (updateLevels)
-	  edge.edge_level = mesh->getEdgeLevel(i); 
+	  edge.edge_level = mesh->getEdgeLevel(i,halfEdgesGeom[i].vtx_index,halfEdgesGeom[i].next()->vtx_index); 
         
 	if (updateEdgeCreases) {
 	  if (edge.hasOpposite()) // leave weight at inf for borders
@@ -630,8 +873,16 @@ namespace embree
     update |= mesh->vertex_crease_weights.isModified(); 
     update |= mesh->levels.isModified();
 
+    /* changes of some faces of dynamic meshes only require a local update */
+    bool incremental = recalculate && !mesh->faceVertices.isModified() && !mesh->holes.isModified();
+    incremental &= !mesh->edge_creases.isModified() && !mesh->edge_crease_weights.isModified();
+    incremental &= !mesh->vertex_creases.isModified() && !mesh->vertex_crease_weights.isModified();
+    incremental &= !mesh->levels.isModified();
+    incremental &= this == &mesh->topology[0] || !mesh->topology[0].vertexIndices.isModified();
+
     /* now either recalculate or update the half edges */
-    if (recalculate) calculateHalfEdges();
+    if (incremental && calculateHalfEdgesIncremental()) {}
+    else if (recalculate) calculateHalfEdges();
     else if (update) updateHalfEdges();
    
     /* cleanup some state for static scenes */
@@ -675,6 +926,10 @@ namespace embree
     double t0 = getSeconds();
 
     invalid_face.resize(numFaces()*numTimeSteps);
+
+    /* view dependent edge levels change with the vertex positions */
+    if (view.enabled && vertices[0].isModified())
+      levels.setModified(true);
  
     /* calculate start edge of each face */
     faceStartEdge.resize(numFaces());
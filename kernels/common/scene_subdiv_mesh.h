@@ -76,10 +76,12 @@ namespace embree
     void update ();
     void updateBuffer (RTCBufferType type);
     void setTessellationRate(float N);
+    void setTessellationView(const RTCTessellationView* view);
     void immutable ();
     bool verify ();
     void setDisplacementFunction (RTCDisplacementFunc func, RTCBounds* bounds);
     void setDisplacementFunction2 (RTCDisplacementFunc2 func, RTCBounds* bounds);
+    void setDisplacementFunctionN (RTCDisplacementFuncN func, RTCBounds* bounds);
     void interpolate(unsigned primID, float u, float v, RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
     void interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
                       RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats);
@@ -121,6 +123,11 @@ namespace embree
       return topology[0].valid(i) && !invalidFace(i,j);
     }
 
+    /*! checks if some displacement function is set */
+    __forceinline bool isDisplaced() const {
+      return displFunc || displFunc2 || displFuncN;
+    }
+
     /*! prints some statistics */
     void printStatistics();
 
@@ -134,17 +141,23 @@ namespace embree
       return vertices[t];
     }
 
-    /* returns tessellation level of edge */
-    __forceinline float getEdgeLevel(const size_t i) const
+    /* returns tessellation level of edge i from vertex v0 to v1 */
+    __forceinline float getEdgeLevel(const size_t i, const unsigned v0, const unsigned v1) const
     {
+      if (view.enabled) return getViewEdgeLevel(v0,v1);
       if (levels) return clamp(levels[i],1.0f,4096.0f); // FIXME: do we want to limit edge level?
       else return clamp(tessellationRate,1.0f,4096.0f); // FIXME: do we want to limit edge level?
     }
 
+    /* returns tessellation level of the edge from vertex v0 to v1 for the current view */
+    float getViewEdgeLevel(const unsigned v0, const unsigned v1) const;
+
   public:
     RTCDisplacementFunc displFunc;    //!< displacement function
     RTCDisplacementFunc2 displFunc2;    //!< displacement function
+    RTCDisplacementFuncN displFuncN;    //!< batched displacement function
     BBox3fa             displBounds;  //!< bounds for maximal displacement 
+    size_t              gridCacheID;  //!< identifies displaced grids of this mesh in the second level tessellation cache
 
     /*! all buffers in this section are provided by the application */
   public:
@@ -209,8 +222,20 @@ namespace embree
 
     private:
       
+      /*! initializes the half edges of face f and optionally outputs their keys */
+      void initHalfEdges(size_t f, KeyHalfEdge* keys);
+
+      /*! links N half edges that share the same key */
+      void linkHalfEdges(const KeyHalfEdge* edges, size_t N);
+
+      /*! pins vertices and edges and calculates the patch type of face f */
+      void finalizeFace(size_t f);
+
       /*! recalculates the half edges */
       void calculateHalfEdges();
+
+      /*! recalculates only the half edges around faces whose vertex indices changed, returns false if a full recalculation is required */
+      bool calculateHalfEdgesIncremental();
       
       /*! updates half edges when recalculation is not necessary */
       void updateHalfEdges();
@@ -279,6 +304,17 @@ namespace embree
     APIBuffer<float> levels;
     float tessellationRate;  // constant rate that is used when levels is not set
 
+    /*! camera used for view dependent tessellation, overrides levels and tessellationRate when enabled */
+    struct View
+    {
+      bool enabled;        //!< true if view dependent tessellation is enabled
+      Vec3fa P;            //!< camera position
+      Vec3fa dir;          //!< normalized viewing direction
+      float scale;         //!< edge level per unit of edge length at distance 1
+      float cullAngle;     //!< half opening angle of the cone enclosing the view frustum
+      float culledLevel;   //!< level of culled edges, negative if culling is disabled
+    } view;
+
     /*! buffer that marks specific faces as holes */
     APIBuffer<unsigned> holes;
 
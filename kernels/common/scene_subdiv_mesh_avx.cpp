@@ -194,6 +194,58 @@ namespace embree
     });
   }
 
+  /*! Evaluates incoherent query points by first sorting them by
+   *  patch, such that each patch gets evaluated for up to 8 query
+   *  points at once. The results of each packet are written into a
+   *  small SOA buffer and scattered to their destination slots. */
+  static void interpolateGrouped(SubdivMeshAVX* mesh, const int* valid, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
+                                 RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats)
+  {
+    /* sort valid query points by patch */
+    dynamic_large_stack_array(uint64_t,keys,numUVs,1024*sizeof(uint64_t));
+    size_t numKeys = 0;
+    for (size_t i=0; i<numUVs; i++) {
+      if (valid && valid[i] != -1) continue;
+      keys[numKeys++] = (uint64_t(primIDs[i]) << 32) | uint64_t(i);
+    }
+    std::sort(&keys[0],&keys[numKeys]);
+
+    /* temporary SOA storage for the results of one packet */
+    const size_t numOut = 8*numFloats;
+    dynamic_large_stack_array(float,out,6*numOut,6*8*16*sizeof(float));
+    float* const dst[6] = { P, dPdu, dPdv, ddPdudu, ddPdvdv, ddPdudv };
+    float* tmp[6];
+    for (size_t k=0; k<6; k++)
+      tmp[k] = dst[k] ? &out[k*numOut] : nullptr;
+
+    for (size_t b=0; b<numKeys;)
+    {
+      /* gather up to 8 query points of the same patch */
+      const unsigned primID = unsigned(keys[b] >> 32);
+      __aligned(32) unsigned index[8];
+      __aligned(32) float uu[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+      __aligned(32) float vv[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+      size_t n = 0;
+      for (; n<8 && b<numKeys && unsigned(keys[b] >> 32) == primID; n++, b++) {
+        index[n] = unsigned(keys[b]);
+        uu[n] = u[index[n]];
+        vv[n] = v[index[n]];
+      }
+
+      const vbool8 valid1 = vint8(step) < vint8(int(n));
+      mesh->interpolateHelper(valid1,vint8(primID),vfloat8::load(uu),vfloat8::load(vv),8,buffer,
+                              tmp[0],tmp[1],tmp[2],tmp[3],tmp[4],tmp[5],numFloats);
+
+      /* scatter results to the destination arrays */
+      for (size_t k=0; k<6; k++) {
+        if (!dst[k]) continue;
+        for (size_t j=0; j<numFloats; j++)
+          for (size_t l=0; l<n; l++)
+            dst[k][j*numUVs+index[l]] = tmp[k][j*8+l];
+      }
+    }
+  }
+
   void SubdivMeshAVX::interpolateN(const void* valid_i, const unsigned* primIDs, const float* u, const float* v, size_t numUVs, 
                                    RTCBufferType buffer, float* P, float* dPdu, float* dPdv, float* ddPdudu, float* ddPdvdv, float* ddPdudv, size_t numFloats)
   {
@@ -203,6 +255,25 @@ namespace embree
 #endif
 
     const int* valid = (const int*) valid_i;
+
+    /* packets of incoherent query points would evaluate each patch
+     * with only few active lanes, thus we group such queries by patch */
+    if (numUVs >= 16)
+    {
+      size_t numValid = 0, numRuns = 0;
+      unsigned lastPrimID = -1;
+      for (size_t i=0; i<numUVs; i++) {
+        if (valid && valid[i] != -1) continue;
+        numValid++;
+        numRuns += primIDs[i] != lastPrimID;
+        lastPrimID = primIDs[i];
+      }
+      if (4*numRuns > numValid) {
+        interpolateGrouped(this,valid,primIDs,u,v,numUVs,buffer,P,dPdu,dPdv,ddPdudu,ddPdvdv,ddPdudv,numFloats);
+        AVX_ZERO_UPPER();
+        return;
+      }
+    }
     
     for (size_t i=0; i<numUVs;) 
     {
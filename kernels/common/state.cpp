@@ -90,6 +90,8 @@ namespace embree
     object_accel_mb_max_leaf_size = 1;
 
     max_spatial_split_replications = 2.0f;
+    build_memory_limit = 0;
+    build_retention_factor = 2.0f;
 
     tessellation_cache_size = 128*1024*1024;
 
@@ -100,6 +102,10 @@ namespace embree
       if (singledevice) tessellation_cache_size = 128*1024*1024;
 #endif
 
+    grid_cache_size = 0;
+    grid_cache_file = "";
+    trace_file = "";
+
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
 
@@ -125,6 +131,7 @@ namespace embree
     if (hasISA(AVX512KNL)) set_affinity = true;
 
     start_threads = false;
+    idle_spin_rounds = 32;
 
     error_function = nullptr;
     error_function2 = nullptr;
@@ -243,6 +250,9 @@ namespace embree
       
       else if (tok == Token::Id("start_threads")&& cin->trySymbol("=")) 
         start_threads = cin->get().Int();
+
+      else if (tok == Token::Id("idle_spin_rounds")&& cin->trySymbol("=")) 
+        idle_spin_rounds = cin->get().Int();
       
       else if (tok == Token::Id("isa") && cin->trySymbol("=")) {
         std::string isa = toLowerCase(cin->get().Identifier());
@@ -380,10 +390,22 @@ namespace embree
       else if (tok == Token::Id("max_spatial_split_replications") && cin->trySymbol("="))
         max_spatial_split_replications = cin->get().Float();
 
+      else if (tok == Token::Id("build_memory_limit") && cin->trySymbol("="))
+        build_memory_limit = size_t(cin->get().Float()*1024.0f*1024.0f);
+
+      else if (tok == Token::Id("build_retention_factor") && cin->trySymbol("="))
+        build_retention_factor = cin->get().Float();
+
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("grid_cache_size") && cin->trySymbol("="))
+        grid_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("grid_cache_file") && cin->trySymbol("="))
+        grid_cache_file = cin->get().String();
+      else if (tok == Token::Id("trace_file") && cin->trySymbol("="))
+        trace_file = cin->get().String();
 
       cin->trySymbol(","); // optional , separator
     }
@@ -399,9 +421,15 @@ namespace embree
     std::cout << "  build threads = " << numThreads   << std::endl;
     std::cout << "  start_threads = " << start_threads << std::endl;
     std::cout << "  affinity      = " << set_affinity << std::endl;
+    std::cout << "  idle_spin_rounds = " << idle_spin_rounds << std::endl;
     std::cout << "  verbosity     = " << verbose << std::endl;
     std::cout << "  cache_size    = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
+    std::cout << "  grid_cache_size = " << float(grid_cache_size)*1E-6 << " MB" << std::endl;
+    std::cout << "  grid_cache_file = " << grid_cache_file << std::endl;
+    std::cout << "  trace_file    = " << trace_file << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  build_memory_limit = " << float(build_memory_limit)*1E-6 << " MB" << std::endl;
+    std::cout << "  build_retention_factor = " << build_retention_factor << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel         = " << tri_accel << std::endl;
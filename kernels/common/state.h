@@ -106,7 +106,12 @@ namespace embree
 
   public:
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
+    size_t build_memory_limit;             //!< maximal bytes of temporary primitive references per build (0 = unlimited)
+    float build_retention_factor;          //!< dynamic scenes retain build buffers up to this factor times the required size across commits (0 = no retention)
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    size_t grid_cache_size;                //!< size of the second level cache for displaced grids (0 = disabled)
+    std::string grid_cache_file;           //!< file the second level cache gets mapped to (empty = memory)
+    std::string trace_file;                //!< file build events get written to in Chrome trace format (empty = no tracing)
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -126,6 +131,7 @@ namespace embree
     size_t numThreads;                     //!< number of threads to use in builders
     bool set_affinity;                     //!< sets affinity for worker threads
     bool start_threads;                    //!< true when threads should be started at device creation time
+    size_t idle_spin_rounds;               //!< number of spin rounds before an idle worker thread of the internal tasking system parks
     int enabled_cpu_features;              //!< CPU ISA features to use
     int enabled_builder_cpu_features;      //!< CPU ISA features to use for builders only
 
@@ -35,6 +35,25 @@ namespace embree
     static const size_t numBezierSubdivisions = 3;
 #endif
 
+    /*! Calculates how deep a curve has to get subdivided before the
+     *  Newton iterations can take over. The chord deviation of a curve
+     *  segment of parametric length h is bounded by 3/4*h^2 times the
+     *  largest second difference of the control points. Nearly straight
+     *  curves terminate as soon as this bound drops below a fraction of
+     *  the curve radius, all other curves use numBezierSubdivisions. */
+    __forceinline size_t bezierSubdivisionDepth(const Vec3fa& p0, const Vec3fa& p1, const Vec3fa& p2, const Vec3fa& p3)
+    {
+      const float D = sqrt(max(dot(p0-2.0f*p1+p2,p0-2.0f*p1+p2),dot(p1-2.0f*p2+p3,p1-2.0f*p2+p3)));
+      const float tolerance = 0.25f*min(p0.w,p1.w,p2.w,p3.w);
+      const float h2 = 1.0f/float((VSIZEX-1)*(VSIZEX-1));
+      float deviation = 0.75f*D*h2;
+      size_t depth = 1;
+      while (depth < numBezierSubdivisions && deviation > tolerance) {
+        deviation *= h2; depth++;
+      }
+      return depth;
+    }
+
     template<typename NativeCurve3fa>
       struct BezierCurveHit
     {
@@ -127,10 +146,8 @@ namespace embree
 
     template<typename NativeCurve3fa, typename Ray, typename Epilog>
       bool intersect_bezier_recursive_jacobian(const Ray& ray, const float dt, const NativeCurve3fa& curve, 
-                                               const float u0, const float u1, const size_t depth, const Epilog& epilog)
+                                               const float u0, const float u1, const size_t depth, const size_t maxDepth, const Epilog& epilog)
     {
-      int maxDepth = numBezierSubdivisions;
-      //int maxDepth = Device::debug_int1+1;
       const Vec3fa org = zero;
       const Vec3fa dir = ray.dir;
 
@@ -200,7 +217,7 @@ namespace embree
         const size_t termDepth = unstable0[i] ? maxDepth+1 : maxDepth;
         if (depth >= termDepth) found = found | intersect_bezier_iterative_jacobian(ray,dt,curve,u_outer0[i],tp0.lower[i],epilog);
         //if (depth >= maxDepth) found = found | intersect_bezier_iterative_debug   (ray,dt,curve,i,u_outer0,tp0,h0,h1,Ng_outer0,dP0du,dP3du,epilog);
-        else                   found = found | intersect_bezier_recursive_jacobian(ray,dt,curve,vu0[i+0],vu0[i+1],depth+1,epilog);
+        else                   found = found | intersect_bezier_recursive_jacobian(ray,dt,curve,vu0[i+0],vu0[i+1],depth+1,maxDepth,epilog);
         valid0 &= tp0.lower+dt < ray.tfar;
       }
       valid1 &= tp1.lower+dt < ray.tfar;
@@ -212,7 +229,7 @@ namespace embree
         const size_t termDepth = unstable1[i] ? maxDepth+1 : maxDepth;
         if (depth >= termDepth) found = found | intersect_bezier_iterative_jacobian(ray,dt,curve,u_outer1[i],tp1.upper[i],epilog);
         //if (depth >= maxDepth) found = found | intersect_bezier_iterative_debug   (ray,dt,curve,i,u_outer1,tp1,h0,h1,Ng_outer1,dP0du,dP3du,epilog);
-        else                   found = found | intersect_bezier_recursive_jacobian(ray,dt,curve,vu0[i+0],vu0[i+1],depth+1,epilog);
+        else                   found = found | intersect_bezier_recursive_jacobian(ray,dt,curve,vu0[i+0],vu0[i+1],depth+1,maxDepth,epilog);
         valid1 &= tp1.lower+dt < ray.tfar;
       }
       return found;
@@ -241,7 +258,8 @@ namespace embree
         const Vec3fa p3 = v3-ref;
 
         const NativeCurve3fa curve(p0,p1,p2,p3);
-        return intersect_bezier_recursive_jacobian(ray,dt,curve,0.0f,1.0f,1,epilog);
+        const size_t maxDepth = bezierSubdivisionDepth(p0,p1,p2,p3);
+        return intersect_bezier_recursive_jacobian(ray,dt,curve,0.0f,1.0f,1,maxDepth,epilog);
       }
     };
 
@@ -279,7 +297,8 @@ namespace embree
         const Vec3fa p3 = v3-ref;
 
         const NativeCurve3fa curve(p0,p1,p2,p3);
-        return intersect_bezier_recursive_jacobian(ray,dt,curve,0.0f,1.0f,1,epilog);
+        const size_t maxDepth = bezierSubdivisionDepth(p0,p1,p2,p3);
+        return intersect_bezier_recursive_jacobian(ray,dt,curve,0.0f,1.0f,1,maxDepth,epilog);
       }
     };
   }
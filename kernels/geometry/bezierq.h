@@ -0,0 +1,150 @@
+// ======================================================================== //
+// Copyright 2009-2017 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Stores M curves with their control points quantized to 16 bits
+   * relative to the bounds of all control points of the block. */
+  template <int M>
+  struct BezierMq
+  {
+    typedef Vec4<vfloat<M>> Vec4vfM;
+
+    /* Virtual interface to query information about the curve type */
+    struct Type : public PrimitiveType
+    {
+      Type();
+      size_t size(const char* This) const;
+    };
+    static Type type;
+
+  public:
+
+    /* Returns maximal number of stored curves */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns required number of primitive blocks for N curves */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+  public:
+
+    /* Default constructor */
+    __forceinline BezierMq() {}
+
+    /* Returns a mask that tells which curves are valid */
+    __forceinline vbool<M> valid() const { return primIDs != vint<M>(-1); }
+
+    /* Returns if the specified curve is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return primIDs[i] != -1; }
+
+    /* Returns the number of stored curves */
+    __forceinline size_t size() const { return __bsf(~movemask(valid())); }
+
+    /* Returns the geometry IDs */
+    __forceinline vint<M> geomID() const { return geomIDs; }
+    __forceinline int geomID(const size_t i) const { assert(i<M); return geomIDs[i]; }
+
+    /* Returns the primitive IDs */
+    __forceinline vint<M> primID() const { return primIDs; }
+    __forceinline int primID(const size_t i) const { assert(i<M); return primIDs[i]; }
+
+    /* Dequantizes the k'th control point of all curves */
+    __forceinline Vec4vfM point(const size_t k) const
+    {
+      return Vec4vfM(madd(vfloat<M>::load(q[k][0]),vfloat<M>(scale.x),vfloat<M>(lower.x)),
+                     madd(vfloat<M>::load(q[k][1]),vfloat<M>(scale.y),vfloat<M>(lower.y)),
+                     madd(vfloat<M>::load(q[k][2]),vfloat<M>(scale.z),vfloat<M>(lower.z)),
+                     madd(vfloat<M>::load(q[k][3]),vfloat<M>(scale.w),vfloat<M>(lower.w)));
+    }
+
+    /* Dequantizes the control points of all curves */
+    __forceinline void gather(Vec4vfM& p0, Vec4vfM& p1, Vec4vfM& p2, Vec4vfM& p3) const
+    {
+      p0 = point(0);
+      p1 = point(1);
+      p2 = point(2);
+      p3 = point(3);
+    }
+
+    /* Fill curves from curve list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene)
+    {
+      Vec3fa p[4][M];
+      Vec3fa plower(pos_inf), pupper(neg_inf);
+
+      for (size_t i=0; i<M; i++)
+      {
+        if (begin<end)
+        {
+          const PrimRef& prim = prims[begin++];
+          const NativeCurves* curves = scene->get<NativeCurves>(prim.geomID());
+          const unsigned id = curves->curve(prim.primID());
+          for (size_t k=0; k<4; k++) {
+            p[k][i] = curves->vertex(id+k);
+            plower = min(plower,p[k][i]);
+            pupper = max(pupper,p[k][i]);
+          }
+          geomIDs[i] = prim.geomID();
+          primIDs[i] = prim.primID();
+        }
+        else
+        {
+          assert(i);
+          for (size_t k=0; k<4; k++) p[k][i] = p[k][i-1];
+          geomIDs[i] = geomIDs[i-1];
+          primIDs[i] = -1;
+        }
+      }
+
+      /* quantize all control points relative to their bounds, including the radius stored in w */
+      lower = plower;
+      scale = pupper-plower;
+      const float* l = (const float*)&lower;
+      const float* s = (const float*)&scale;
+      for (size_t i=0; i<M; i++)
+      {
+        for (size_t k=0; k<4; k++)
+        {
+          const float* v = (const float*)&p[k][i];
+          for (size_t c=0; c<4; c++) {
+            const float f = s[c] > 0.0f ? (v[c]-l[c])/s[c] : 0.0f;
+            q[k][c][i] = (unsigned short) clamp(floorf(f*65535.0f+0.5f),0.0f,65535.0f);
+          }
+        }
+      }
+    }
+
+    friend std::ostream& operator<<(std::ostream& cout, const BezierMq& b) {
+      return cout << "Bezier" << M << "q { lower = " << b.lower << ", scale = " << b.scale << ", geomIDs = " << b.geomIDs << ", primIDs = " << b.primIDs << " }";
+    }
+
+  public:
+    Vec3fa lower;               //!< lower bounds of all control points (x,y,z,r)
+    Vec3fa scale;               //!< extent of all control points (x,y,z,r)
+    unsigned short q[4][4][M];  //!< quantized control points [point][x,y,z,r][curve]
+    vint<M> geomIDs;            //!< geometry IDs
+    vint<M> primIDs;            //!< primitive IDs
+  };
+
+  template<int M>
+  typename BezierMq<M>::Type BezierMq<M>::type;
+
+  typedef BezierMq<4> Bezier4q;
+}
@@ -0,0 +1,225 @@
+// ======================================================================== //
+// Copyright 2009-2017 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "bezierq.h"
+#include "bezier_hair_intersector.h"
+#include "bezier_ribbon_intersector.h"
+#include "bezier_curve_intersector.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Intersector for a single ray with M quantized bezier curves. */
+    template<int M>
+      struct BezierMqIntersector1
+    {
+      typedef BezierMq<M> Primitive;
+      typedef Vec4<vfloat<M>> Vec4vfM;
+
+      struct PrecalculationsBase
+      {
+        __forceinline PrecalculationsBase() {}
+
+        __forceinline PrecalculationsBase(const Ray& ray, const void* ptr)
+          : intersectorHair(ray,ptr), intersectorCurve(ray,ptr) {}
+
+        Bezier1Intersector1<Curve3fa> intersectorHair;
+        BezierCurve1Intersector1<Curve3fa> intersectorCurve;
+      };
+
+      typedef Intersector1Precalculations<PrecalculationsBase> Precalculations;
+
+      static __forceinline Vec3fa extract(const Vec4vfM& p, size_t i) {
+        return Vec3fa(p.x[i],p.y[i],p.z[i],p.w[i]);
+      }
+
+      /*! Returns the curves whose control point hull, extended by the
+       *  maximal radius, may overlap the ray. Tests all M curves at once
+       *  in ray space before the expensive per curve intersection. */
+      static __forceinline size_t cull(const Vec4vfM& p0, const Vec4vfM& p1, const Vec4vfM& p2, const Vec4vfM& p3, const Primitive& prim,
+                                       const LinearSpace3fa& space, const float depth_scale, const Vec3fa& org, const float tnear, const float tfar)
+      {
+        const Vec3<vfloat<M>> vx(space.vx.x,space.vx.y,space.vx.z);
+        const Vec3<vfloat<M>> vy(space.vy.x,space.vy.y,space.vy.z);
+        const Vec3<vfloat<M>> vz(space.vz.x,space.vz.y,space.vz.z);
+        auto xfm = [&] (const Vec4vfM& p) -> Vec3<vfloat<M>> {
+          const vfloat<M> dx = p.x-vfloat<M>(org.x), dy = p.y-vfloat<M>(org.y), dz = p.z-vfloat<M>(org.z);
+          return Vec3<vfloat<M>>(madd(dx,vx.x,madd(dy,vy.x,dz*vz.x)),
+                                 madd(dx,vx.y,madd(dy,vy.y,dz*vz.y)),
+                                 madd(dx,vx.z,madd(dy,vy.z,dz*vz.z)));
+        };
+        const Vec3<vfloat<M>> q0 = xfm(p0), q1 = xfm(p1), q2 = xfm(p2), q3 = xfm(p3);
+        const vfloat<M> r = max(max(p0.w,p1.w),max(p2.w,p3.w));
+        const Vec3<vfloat<M>> lower = min(min(q0,q1),min(q2,q3)) - Vec3<vfloat<M>>(r);
+        const Vec3<vfloat<M>> upper = max(max(q0,q1),max(q2,q3)) + Vec3<vfloat<M>>(r);
+        vbool<M> valid = prim.valid();
+        valid &= (lower.x <= vfloat<M>(zero)) & (upper.x >= vfloat<M>(zero));
+        valid &= (lower.y <= vfloat<M>(zero)) & (upper.y >= vfloat<M>(zero));
+        valid &= (lower.z*depth_scale <= vfloat<M>(tfar)) & (upper.z*depth_scale >= vfloat<M>(tnear));
+        return movemask(valid);
+      }
+
+      static __forceinline void intersect(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& prim)
+      {
+        Vec4vfM p0,p1,p2,p3; prim.gather(p0,p1,p2,p3);
+        size_t mask = cull(p0,p1,p2,p3,prim,pre.intersectorHair.ray_space,pre.intersectorHair.depth_scale,ray.org,ray.tnear,ray.tfar);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          STAT3(normal.trav_prims,1,1,1);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const NativeCurves* geom = (NativeCurves*)context->scene->get(geomID);
+          const Vec3fa a0 = extract(p0,i), a1 = extract(p1,i), a2 = extract(p2,i), a3 = extract(p3,i);
+          if (likely(geom->subtype == NativeCurves::HAIR))
+            pre.intersectorHair.intersect(ray,a0,a1,a2,a3,geom->tessellationRate,Intersect1EpilogMU<VSIZEX,true>(ray,context,geomID,primID));
+          else 
+            pre.intersectorCurve.intersect(ray,a0,a1,a2,a3,Intersect1Epilog1<true>(ray,context,geomID,primID));
+        }
+      }
+      
+      static __forceinline bool occluded(const Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive& prim)
+      {
+        Vec4vfM p0,p1,p2,p3; prim.gather(p0,p1,p2,p3);
+        size_t mask = cull(p0,p1,p2,p3,prim,pre.intersectorHair.ray_space,pre.intersectorHair.depth_scale,ray.org,ray.tnear,ray.tfar);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          STAT3(shadow.trav_prims,1,1,1);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const NativeCurves* geom = (NativeCurves*)context->scene->get(geomID);
+          const Vec3fa a0 = extract(p0,i), a1 = extract(p1,i), a2 = extract(p2,i), a3 = extract(p3,i);
+          if (likely(geom->subtype == NativeCurves::HAIR)) {
+            if (pre.intersectorHair.intersect(ray,a0,a1,a2,a3,geom->tessellationRate,Occluded1EpilogMU<VSIZEX,true>(ray,context,geomID,primID)))
+              return true;
+          } else {
+            if (pre.intersectorCurve.intersect(ray,a0,a1,a2,a3,Occluded1Epilog1<true>(ray,context,geomID,primID)))
+              return true;
+          }
+        }
+        return false;
+      }
+
+      /*! Intersect an array of rays with an array of M primitives. */
+      static __forceinline size_t intersect(Precalculations* pre, size_t valid, Ray** rays, IntersectContext* context,  size_t ty, const Primitive* prim, size_t num)
+      {
+        size_t valid_isec = 0;
+        do {
+          const size_t i = __bscf(valid);
+          const float old_far = rays[i]->tfar;
+          for (size_t n=0; n<num; n++)
+            intersect(pre[i],*rays[i],context,prim[n]);
+          valid_isec |= (rays[i]->tfar < old_far) ? ((size_t)1 << i) : 0;            
+        } while(unlikely(valid));
+        return valid_isec;
+      }
+    };
+
+    /*! Intersector for a single ray from a ray packet with M quantized bezier curves. */
+    template<int M, int K>
+      struct BezierMqIntersectorK
+    {
+      typedef BezierMq<M> Primitive;
+      typedef Vec4<vfloat<M>> Vec4vfM;
+
+      struct PrecalculationsBase
+      {
+        __forceinline PrecalculationsBase() {}
+
+        __forceinline PrecalculationsBase(const vbool<K>& valid, const RayK<K>& ray)
+          : intersectorHair(valid,ray), intersectorCurve(valid,ray) {}
+
+        __forceinline PrecalculationsBase(const RayK<K>& ray, size_t k)
+          : intersectorHair(ray,k), intersectorCurve(ray,k) {}
+
+        Bezier1IntersectorK<Curve3fa,K> intersectorHair;
+        BezierCurve1IntersectorK<Curve3fa,K> intersectorCurve;
+      };
+
+      typedef IntersectorKPrecalculations<K,PrecalculationsBase> Precalculations;
+
+      static __forceinline Vec3fa extract(const Vec4vfM& p, size_t i) {
+        return Vec3fa(p.x[i],p.y[i],p.z[i],p.w[i]);
+      }
+      
+      static __forceinline void intersect(Precalculations& pre, RayK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim) 
+      {
+        Vec4vfM p0,p1,p2,p3; prim.gather(p0,p1,p2,p3);
+        const Vec3fa org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        size_t mask = BezierMqIntersector1<M>::cull(p0,p1,p2,p3,prim,pre.intersectorHair.ray_space[k],pre.intersectorHair.depth_scale[k],org,ray.tnear[k],ray.tfar[k]);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          STAT3(normal.trav_prims,1,1,1);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const NativeCurves* geom = (NativeCurves*)context->scene->get(geomID);
+          const Vec3fa a0 = extract(p0,i), a1 = extract(p1,i), a2 = extract(p2,i), a3 = extract(p3,i);
+          if (likely(geom->subtype == NativeCurves::HAIR))
+            pre.intersectorHair.intersect(ray,k,a0,a1,a2,a3,geom->tessellationRate,Intersect1KEpilogMU<VSIZEX,K,true>(ray,k,context,geomID,primID));
+          else
+            pre.intersectorCurve.intersect(ray,k,a0,a1,a2,a3,Intersect1KEpilog1<K,true>(ray,k,context,geomID,primID));
+        }
+      }
+
+      static __forceinline void intersect(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& prim)
+      {
+        int mask = movemask(valid_i);
+        while (mask) intersect(pre,ray,__bscf(mask),context,prim);
+      }
+ 
+      static __forceinline bool occluded(Precalculations& pre, RayK<K>& ray, const size_t k, IntersectContext* context, const Primitive& prim) 
+      {
+        Vec4vfM p0,p1,p2,p3; prim.gather(p0,p1,p2,p3);
+        const Vec3fa org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
+        size_t mask = BezierMqIntersector1<M>::cull(p0,p1,p2,p3,prim,pre.intersectorHair.ray_space[k],pre.intersectorHair.depth_scale[k],org,ray.tnear[k],ray.tfar[k]);
+        while (mask)
+        {
+          const size_t i = __bscf(mask);
+          STAT3(shadow.trav_prims,1,1,1);
+          const unsigned geomID = prim.geomID(i);
+          const unsigned primID = prim.primID(i);
+          const NativeCurves* geom = (NativeCurves*)context->scene->get(geomID);
+          const Vec3fa a0 = extract(p0,i), a1 = extract(p1,i), a2 = extract(p2,i), a3 = extract(p3,i);
+          if (likely(geom->subtype == NativeCurves::HAIR)) {
+            if (pre.intersectorHair.intersect(ray,k,a0,a1,a2,a3,geom->tessellationRate,Occluded1KEpilogMU<VSIZEX,K,true>(ray,k,context,geomID,primID)))
+              return true;
+          } else {
+            if (pre.intersectorCurve.intersect(ray,k,a0,a1,a2,a3,Occluded1KEpilog1<K,true>(ray,k,context,geomID,primID)))
+              return true;
+          }
+        }
+        return false;
+      }
+
+      static __forceinline vbool<K> occluded(const vbool<K>& valid_i, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive& prim)
+      {
+        vbool<K> valid_o = false;
+        int mask = movemask(valid_i);
+        while (mask) {
+          size_t k = __bscf(mask);
+          if (occluded(pre,ray,k,context,prim))
+            set(valid_o, k);
+        }
+        return valid_o;
+      }
+    };
+  }
+}
@@ -35,33 +35,26 @@ namespace embree
       dynamic_large_stack_array(float,local_grid_x,temp_size,64*64*sizeof(float));
       dynamic_large_stack_array(float,local_grid_y,temp_size,64*64*sizeof(float));
       dynamic_large_stack_array(float,local_grid_z,temp_size,64*64*sizeof(float));
-      dynamic_large_stack_array(float,local_grid_uv,temp_size,64*64*sizeof(float));
+
+      /* evaluating displacements is expensive, thus the displaced grids of entire patches are kept in the second level cache */
+      const bool cacheGrid = geom->isDisplaced() && width == swidth && height == sheight && SharedGridCache::sharedGridCache.enabled();
+      SharedGridCache::Key key;
+      if (cacheGrid) key = SharedGridCache::Key(geom->gridCacheID,primID,geom->parent->commitCounterSubdiv,time_steps,patches->u,patches->v,patches->level);
+      const bool cached = cacheGrid && SharedGridCache::sharedGridCache.lookup(key,gridData(0),time_steps*gridBytes);
 
       /* first create the grids for each time step */
-      for (size_t t=0; t<time_steps; t++)
+      for (size_t t=0; t<time_steps && !cached; t++)
       {
         /* compute vertex grid (+displacement) */
         evalGrid(patches[t],x0,x1,y0,y1,swidth,sheight,
                  local_grid_x,local_grid_y,local_grid_z,local_grid_u,local_grid_v,geom);
         
-        /* encode UVs */
-        for (unsigned i=0; i<dim_offset; i+=VSIZEX) {
-          const vintx iu = (vintx) clamp(vfloatx::load(&local_grid_u[i])*0xFFFF, vfloatx(0.0f), vfloatx(0xFFFF));
-          const vintx iv = (vintx) clamp(vfloatx::load(&local_grid_v[i])*0xFFFF, vfloatx(0.0f), vfloatx(0xFFFF));
-          vintx::storeu(&local_grid_uv[i], (iv << 16) | iu);
-        }
-
-        /* copy temporary data to compact grid */
-        float* const grid_x  = (float*)(gridData(t) + 0*dim_offset);
-        float* const grid_y  = (float*)(gridData(t) + 1*dim_offset);
-        float* const grid_z  = (float*)(gridData(t) + 2*dim_offset);
-        int  * const grid_uv = (int*  )(gridData(t) + 3*dim_offset);
-        memcpy(grid_x, local_grid_x, dim_offset*sizeof(float));
-        memcpy(grid_y, local_grid_y, dim_offset*sizeof(float));
-        memcpy(grid_z, local_grid_z, dim_offset*sizeof(float));
-        memcpy(grid_uv,local_grid_uv,dim_offset*sizeof(int));       
+        storeGrid(t,local_grid_x,local_grid_y,local_grid_z,local_grid_u,local_grid_v);
       }
 
+      if (cacheGrid && !cached)
+        SharedGridCache::sharedGridCache.insert(key,gridData(0),time_steps*gridBytes);
+
       /* create normal BVH when no motion blur is active */
       if (time_steps == 1) {
         root(0) = buildBVH(0,bounds_o);
@@ -89,6 +82,35 @@ namespace embree
       }
     }
 
+    GridSOA::GridSOA(const unsigned geomID, const unsigned primID, const unsigned width, const unsigned height,
+                     const float* grid_x, const float* grid_y, const float* grid_z, const float* grid_u, const float* grid_v,
+                     const size_t bvhBytes, const size_t gridBytes, BBox3fa* bounds_o)
+      : align0(0), 
+        time_steps_global(1), time_steps(1), width(width), height(height), dim_offset(width*height),
+        geomID(geomID), primID(primID), 
+        bvhBytes(unsigned(bvhBytes)), gridOffset(unsigned(bvhBytes)), gridBytes(unsigned(gridBytes)), rootOffset(unsigned(gridOffset+gridBytes))
+    {
+      storeGrid(0,grid_x,grid_y,grid_z,grid_u,grid_v);
+      root(0) = buildBVH(0,bounds_o);
+    }
+
+    void GridSOA::storeGrid(size_t t, const float* grid_x, const float* grid_y, const float* grid_z, const float* grid_u, const float* grid_v)
+    {
+      /* encode UVs */
+      dynamic_large_stack_array(int,local_grid_uv,dim_offset+VSIZEX,64*64*sizeof(int));
+      for (unsigned i=0; i<dim_offset; i+=VSIZEX) {
+        const vintx iu = (vintx) clamp(vfloatx::loadu(&grid_u[i])*0xFFFF, vfloatx(0.0f), vfloatx(0xFFFF));
+        const vintx iv = (vintx) clamp(vfloatx::loadu(&grid_v[i])*0xFFFF, vfloatx(0.0f), vfloatx(0xFFFF));
+        vintx::storeu(&local_grid_uv[i], (iv << 16) | iu);
+      }
+
+      /* copy temporary data to compact grid */
+      memcpy(gridData(t) + 0*dim_offset, grid_x, dim_offset*sizeof(float));
+      memcpy(gridData(t) + 1*dim_offset, grid_y, dim_offset*sizeof(float));
+      memcpy(gridData(t) + 2*dim_offset, grid_z, dim_offset*sizeof(float));
+      memcpy(gridData(t) + 3*dim_offset, local_grid_uv, dim_offset*sizeof(int));
+    }
+
     size_t GridSOA::getBVHBytes(const GridRange& range, const size_t nodeBytes, const size_t leafBytes)
     {
       if (range.hasLeafSize()) 
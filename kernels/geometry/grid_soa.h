@@ -37,6 +37,11 @@ namespace embree
               const unsigned x0, const unsigned x1, const unsigned y0, const unsigned y1, const unsigned swidth, const unsigned sheight,
               const SubdivMesh* const geom, const size_t bvhBytes, const size_t gridBytes, BBox3fa* bounds_o = nullptr);
 
+      /*! GridSOA constructor for already evaluated grids */
+      GridSOA(const unsigned geomID, const unsigned primID, const unsigned width, const unsigned height,
+              const float* grid_x, const float* grid_y, const float* grid_z, const float* grid_u, const float* grid_v,
+              const size_t bvhBytes, const size_t gridBytes, BBox3fa* bounds_o = nullptr);
+
       /*! Subgrid creation */
       template<typename Allocator>
         static GridSOA* create(const SubdivPatch1Base* patches, const unsigned time_steps, const unsigned time_steps_global,
@@ -66,6 +71,26 @@ namespace embree
         return create(patches,time_steps,time_steps_global,0,patches->grid_u_res-1,0,patches->grid_v_res-1,scene,alloc,bounds_o);
       }
 
+      /*! Subgrid creation from already evaluated and displaced grid without motion blur, the grid arrays have to be readable VSIZEX elements past the end */
+      template<typename Allocator>
+        static GridSOA* create(const unsigned geomID, const unsigned primID, unsigned x0, unsigned x1, unsigned y0, unsigned y1,
+                               const float* grid_x, const float* grid_y, const float* grid_z, const float* grid_u, const float* grid_v,
+                               Allocator& alloc, BBox3fa* bounds_o = nullptr)
+      {
+        const unsigned width = x1-x0+1;  
+        const unsigned height = y1-y0+1; 
+        const GridRange range(0,width-1,0,height-1);
+        const size_t bvhBytes  = getBVHBytes(range,sizeof(BVH4::AlignedNode),0);
+        const size_t gridBytes = 4*size_t(width)*size_t(height)*sizeof(float);  
+        size_t rootBytes = sizeof(BVH4::NodeRef);
+#if !defined(__X86_64__)
+        rootBytes += 4; // see above
+#endif
+        void* data = alloc(offsetof(GridSOA,data)+bvhBytes+gridBytes+rootBytes);
+        assert(data);
+        return new (data) GridSOA(geomID,primID,width,height,grid_x,grid_y,grid_z,grid_u,grid_v,bvhBytes,gridBytes,bounds_o);
+      }
+
        /*! returns reference to root */
       __forceinline       BVH4::NodeRef& root(size_t t = 0)       { return (BVH4::NodeRef&)data[rootOffset + t*sizeof(BVH4::NodeRef)]; }
       __forceinline const BVH4::NodeRef& root(size_t t = 0) const { return (BVH4::NodeRef&)data[rootOffset + t*sizeof(BVH4::NodeRef)]; }
@@ -112,6 +137,9 @@ namespace embree
         return bounds;
       }
 
+      /*! Encodes the UVs and copies the grid of some time step into the compact grid, the input arrays need to be padded. */
+      void storeGrid(size_t time, const float* grid_x, const float* grid_y, const float* grid_z, const float* grid_u, const float* grid_v);
+
       /*! Evaluates grid over patch and builds BVH4 tree over the grid. */
       BVH4::NodeRef buildBVH(size_t time, BBox3fa* bounds_o);
       
@@ -45,34 +45,19 @@ namespace embree
       };
     
     template<int M>
-      struct LineIntersector1
+      struct FlatLineIntersector
       {
         typedef Vec3<vfloat<M>> Vec3vfM;
         typedef Vec4<vfloat<M>> Vec4vfM;
-        
-        struct Precalculations
-        {
-          __forceinline Precalculations() {}
 
-          __forceinline Precalculations(const Ray& ray, const void* ptr)
-          {
-            const float s = rsqrt(dot(ray.dir,ray.dir));
-            depth_scale = s;
-            ray_space = frame(s*ray.dir).transposed();
-          }
-          
-          vfloat<M> depth_scale;
-          LinearSpace3<Vec3vfM> ray_space;
-        };
-        
-        template<typename Epilog>
-        static __forceinline bool intersect(Ray& ray, const Precalculations& pre,
-                                            const Vec4vfM& v0, const Vec4vfM& v1,
-                                            const Epilog& epilog)
+        /*! intersects the ray with ray facing ribbons, approximating a cone per segment */
+        static __forceinline vbool<M> intersect(const vbool<M>& valid_i, const Vec3vfM& ray_org, const float ray_tnear, const float ray_tfar,
+                                                const LinearSpace3<Vec3vfM>& ray_space, const vfloat<M>& depth_scale,
+                                                const Vec4vfM& v0, const Vec4vfM& v1, LineIntersectorHitM<M>& hit)
         {
           /* transform end points into ray space */
-          Vec4vfM p0(xfmVector(pre.ray_space,v0.xyz()-Vec3vfM(ray.org)), v0.w);
-          Vec4vfM p1(xfmVector(pre.ray_space,v1.xyz()-Vec3vfM(ray.org)), v1.w);
+          Vec4vfM p0(xfmVector(ray_space,v0.xyz()-ray_org), v0.w);
+          Vec4vfM p1(xfmVector(ray_space,v1.xyz()-ray_org), v1.w);
           
           /* approximative intersection with cone */
           const Vec4vfM v = p1-p0;
@@ -81,11 +66,11 @@ namespace embree
           const vfloat<M> d1 = madd(v.x,v.x,v.y*v.y);
           const vfloat<M> u = clamp(d0*rcp(d1),vfloat<M>(zero),vfloat<M>(one));
           const Vec4vfM p = madd(u,v,p0);
-          const vfloat<M> t = p.z*pre.depth_scale;
+          const vfloat<M> t = p.z*depth_scale;
           const vfloat<M> d2 = madd(p.x,p.x,p.y*p.y);
           const vfloat<M> r = p.w;
           const vfloat<M> r2 = r*r;
-          vbool<M> valid = (d2 <= r2) & (vfloat<M>(ray.tnear) < t) & (t < vfloat<M>(ray.tfar));
+          vbool<M> valid = valid_i & (d2 <= r2) & (vfloat<M>(ray_tnear) < t) & (t < vfloat<M>(ray_tfar));
           if (unlikely(none(valid))) return false;
           
           /* ignore denormalized segments */
@@ -94,7 +79,150 @@ namespace embree
           if (unlikely(none(valid))) return false;
           
           /* update hit information */
-          LineIntersectorHitM<M> hit(u,zero,t,T);
+          hit.vu = select(valid,u,hit.vu);
+          hit.vv = select(valid,vfloat<M>(zero),hit.vv);
+          hit.vt = select(valid,t,hit.vt);
+          hit.vNg = Vec3vfM(select(valid,T.x,hit.vNg.x),select(valid,T.y,hit.vNg.y),select(valid,T.z,hit.vNg.z));
+          return valid;
+        }
+      };
+
+    template<int M>
+      struct RoundLineIntersector
+      {
+        typedef Vec3<vfloat<M>> Vec3vfM;
+        typedef Vec4<vfloat<M>> Vec4vfM;
+
+        /*! returns the first hit distance after tnear of a ray with a sphere, given the discriminant h */
+        static __forceinline vfloat<M> intersectSphere(const vfloat<M>& rcp_dd, const vfloat<M>& od, const vfloat<M>& h, const vfloat<M>& tnear)
+        {
+          const vfloat<M> s = sqrt(max(h,vfloat<M>(zero)));
+          const vfloat<M> t0 = (-od-s)*rcp_dd;
+          const vfloat<M> t1 = (-od+s)*rcp_dd;
+          const vfloat<M> t = select(t0 > tnear, t0, select(t1 > tnear, t1, vfloat<M>(pos_inf)));
+          return select(h >= 0.0f, t, vfloat<M>(pos_inf));
+        }
+
+        /*! intersects the ray with cones between the segment end points, closed by spheres at both end points */
+        static __forceinline vbool<M> intersect(const vbool<M>& valid_i, const Vec3vfM& ray_org, const Vec3vfM& ray_dir, const float ray_tnear, const float ray_tfar,
+                                                const Vec4vfM& v0, const Vec4vfM& v1, LineIntersectorHitM<M>& hit)
+        {
+          const Vec3vfM a = v0.xyz(), b = v1.xyz();
+          const vfloat<M> ra = v0.w, rb = v1.w;
+          const vfloat<M> dd = dot(ray_dir,ray_dir);
+          const vfloat<M> rcp_dd = rcp(dd);
+
+          /* move the ray origin close to the segment for better precision */
+          const Vec3vfM c = vfloat<M>(0.5f)*(a+b);
+          const vfloat<M> t0 = dot(c-ray_org,ray_dir)*rcp_dd;
+          const Vec3vfM org = madd(Vec3vfM(t0),ray_dir,ray_org);
+          const vfloat<M> tnear = vfloat<M>(ray_tnear)-t0;
+          const vfloat<M> tfar  = vfloat<M>(ray_tfar)-t0;
+
+          /* early out if the ray misses the bounding sphere of the segment */
+          const Vec3vfM ba = b-a;
+          const vfloat<M> m0 = dot(ba,ba);
+          const vfloat<M> R = madd(vfloat<M>(0.5f),sqrt(m0),max(ra,rb));
+          const Vec3vfM oc = org-c;
+          vbool<M> valid = valid_i & (dot(oc,oc) <= R*R);
+          if (unlikely(none(valid))) return false;
+          
+          const Vec3vfM oa = org-a;
+          const vfloat<M> m1 = dot(oa,ba);
+          const vfloat<M> m2 = dot(ray_dir,ba);
+          const vfloat<M> m3 = dot(ray_dir,oa);
+          const vfloat<M> m5 = dot(oa,oa);
+
+          /* discriminants of the cone, whose radius varies linearly along the axis, and both end point spheres */
+          const vfloat<M> dr = rb-ra;
+          const vfloat<M> hy = madd(dr,dr,m0);
+          const vfloat<M> k2 = m0*m0*dd - m2*m2*hy;
+          const vfloat<M> k1 = m0*m0*m3 - m1*m2*hy - m0*ra*dr*m2;
+          const vfloat<M> k0 = m0*m0*m5 - m1*m1*hy - m0*ra*madd(2.0f*dr,m1,m0*ra);
+          const vfloat<M> hc = k1*k1 - k2*k0;
+          const vfloat<M> m3b = m3-m2;
+          const vfloat<M> ha = m3*m3 - dd*(m5 - ra*ra);
+          const vfloat<M> hb = m3b*m3b - dd*(m5 - 2.0f*m1 + m0 - rb*rb);
+          const vbool<M> valid_cone = (m0 > 0.0f) & (k2 != 0.0f) & (hc >= 0.0f);
+          valid &= valid_cone | (ha >= 0.0f) | (hb >= 0.0f);
+          if (unlikely(none(valid))) return false;
+
+          /* intersect with the cone */
+          const vfloat<M> sh = sqrt(max(hc,vfloat<M>(zero)));
+          const vfloat<M> rcp_k2 = rcp(k2);
+          const vfloat<M> tc0 = (-k1-sh)*rcp_k2;
+          const vfloat<M> tc1 = (-k1+sh)*rcp_k2;
+          const vfloat<M> tcn = min(tc0,tc1);
+          const vfloat<M> tcf = max(tc0,tc1);
+          const vfloat<M> ycn = madd(tcn,m2,m1);
+          const vfloat<M> ycf = madd(tcf,m2,m1);
+          const vbool<M> valid_cn = valid_cone & (ycn >= 0.0f) & (ycn <= m0) & (tcn > tnear);
+          const vbool<M> valid_cf = valid_cone & (ycf >= 0.0f) & (ycf <= m0) & (tcf > tnear);
+          const vfloat<M> tc = select(valid_cn, tcn, select(valid_cf, tcf, vfloat<M>(pos_inf)));
+
+          /* intersect with the spheres at both end points */
+          const vfloat<M> ta = intersectSphere(rcp_dd,m3,ha,tnear);
+          const vfloat<M> tb = intersectSphere(rcp_dd,m3b,hb,tnear);
+          const vfloat<M> t = min(min(tc,ta),tb);
+          valid &= (t > tnear) & (t < tfar);
+          if (unlikely(none(valid))) return false;
+
+          /* calculate hit information */
+          const Vec3vfM q = madd(Vec3vfM(t),ray_dir,oa);
+          const vfloat<M> y = madd(t,m2,m1);
+          const vfloat<M> rcp_m0 = select(m0 > 0.0f, rcp(m0), vfloat<M>(zero));
+          const vfloat<M> u = clamp(y*rcp_m0,vfloat<M>(zero),vfloat<M>(one));
+          const vfloat<M> sc = y*rcp_m0 + madd(dr,y*rcp_m0,ra)*dr*rcp_m0;
+          const Vec3vfM Ng_cone = q - sc*ba;
+          const Vec3vfM Ng_b = q - ba;
+          const vbool<M> hit_cone = t == tc;
+          const vbool<M> hit_b = t == tb;
+          const Vec3vfM Ng(select(hit_cone, Ng_cone.x, select(hit_b, Ng_b.x, q.x)),
+                           select(hit_cone, Ng_cone.y, select(hit_b, Ng_b.y, q.y)),
+                           select(hit_cone, Ng_cone.z, select(hit_b, Ng_b.z, q.z)));
+
+          /* update hit information */
+          hit.vu = select(valid,u,hit.vu);
+          hit.vv = select(valid,vfloat<M>(zero),hit.vv);
+          hit.vt = select(valid,t+t0,hit.vt);
+          hit.vNg = Vec3vfM(select(valid,Ng.x,hit.vNg.x),select(valid,Ng.y,hit.vNg.y),select(valid,Ng.z,hit.vNg.z));
+          return valid;
+        }
+      };
+    
+    template<int M>
+      struct LineIntersector1
+      {
+        typedef Vec3<vfloat<M>> Vec3vfM;
+        typedef Vec4<vfloat<M>> Vec4vfM;
+        
+        struct Precalculations
+        {
+          __forceinline Precalculations() {}
+
+          __forceinline Precalculations(const Ray& ray, const void* ptr)
+          {
+            const float s = rsqrt(dot(ray.dir,ray.dir));
+            depth_scale = s;
+            ray_space = frame(s*ray.dir).transposed();
+          }
+          
+          vfloat<M> depth_scale;
+          LinearSpace3<Vec3vfM> ray_space;
+        };
+        
+        template<typename Epilog>
+        static __forceinline bool intersect(Ray& ray, const Precalculations& pre,
+                                            const Vec4vfM& v0, const Vec4vfM& v1, const vbool<M>& round,
+                                            const Epilog& epilog)
+        {
+          LineIntersectorHitM<M> hit;
+          vbool<M> valid = false;
+          if (likely(any(!round)))
+            valid |= FlatLineIntersector<M>::intersect(!round,Vec3vfM(ray.org),ray.tnear,ray.tfar,pre.ray_space,pre.depth_scale,v0,v1,hit);
+          if (unlikely(any(round)))
+            valid |= RoundLineIntersector<M>::intersect(round,Vec3vfM(ray.org),Vec3vfM(ray.dir),ray.tnear,ray.tfar,v0,v1,hit);
+          if (none(valid)) return false;
           return epilog(valid,hit);
         }
       };
@@ -123,36 +251,18 @@ namespace embree
         
         template<typename Epilog>
         static __forceinline bool intersect(RayK<K>& ray, size_t k, const Precalculations& pre,
-                                            const Vec4vfM& v0, const Vec4vfM& v1,
+                                            const Vec4vfM& v0, const Vec4vfM& v1, const vbool<M>& round,
                                             const Epilog& epilog)
         {
-          /* transform end points into ray space */
           const Vec3vfM ray_org(ray.org.x[k],ray.org.y[k],ray.org.z[k]);
           const Vec3vfM ray_dir(ray.dir.x[k],ray.dir.y[k],ray.dir.z[k]);
-          Vec4vfM p0(xfmVector(pre.ray_space[k],v0.xyz()-ray_org), v0.w);
-          Vec4vfM p1(xfmVector(pre.ray_space[k],v1.xyz()-ray_org), v1.w);
-          
-          /* approximative intersection with cone */
-          const Vec4vfM v = p1-p0;
-          const Vec4vfM w = -p0;
-          const vfloat<M> d0 = madd(w.x,v.x,w.y*v.y);
-          const vfloat<M> d1 = madd(v.x,v.x,v.y*v.y);
-          const vfloat<M> u = clamp(d0*rcp(d1),vfloat<M>(zero),vfloat<M>(one));
-          const Vec4vfM p = madd(u,v,p0);
-          const vfloat<M> t = p.z*pre.depth_scale[k];
-          const vfloat<M> d2 = madd(p.x,p.x,p.y*p.y);
-          const vfloat<M> r = p.w;
-          const vfloat<M> r2 = r*r;
-          vbool<M> valid = (d2 <= r2) & (vfloat<M>(ray.tnear[k]) < t) & (t < vfloat<M>(ray.tfar[k]));
-          if (unlikely(none(valid))) return false;
-          
-          /* ignore denormalized segments */
-          const Vec3vfM T = v1.xyz()-v0.xyz();
-          valid &= (T.x != vfloat<M>(zero)) | (T.y != vfloat<M>(zero)) | (T.z != vfloat<M>(zero));
-          if (unlikely(none(valid))) return false;
-          
-          /* update hit information */
-          LineIntersectorHitM<M> hit(u,zero,t,T);
+          LineIntersectorHitM<M> hit;
+          vbool<M> valid = false;
+          if (likely(any(!round)))
+            valid |= FlatLineIntersector<M>::intersect(!round,ray_org,ray.tnear[k],ray.tfar[k],pre.ray_space[k],vfloat<M>(pre.depth_scale[k]),v0,v1,hit);
+          if (unlikely(any(round)))
+            valid |= RoundLineIntersector<M>::intersect(round,ray_org,ray_dir,ray.tnear[k],ray.tfar[k],v0,v1,hit);
+          if (none(valid)) return false;
           return epilog(valid,hit);
         }
       };
@@ -17,10 +17,12 @@
 #include "primitive.h"
 #include "bezier1v.h"
 #include "bezier1i.h"
+#include "bezierq.h"
 #include "linei.h"
 #include "triangle.h"
 #include "trianglev.h"
 #include "trianglei.h"
+#include "trianglemeshlet.h"
 #include "trianglev_mb.h"
 #include "trianglei_mb.h"
 #include "quadv.h"
@@ -53,6 +55,17 @@ namespace embree
 
   Bezier1i::Type Bezier1i::type;
 
+  /********************** Bezier4q **************************/
+
+  template<>
+  Bezier4q::Type::Type ()
+    : PrimitiveType("bezier4q",sizeof(Bezier4q),4) {}
+
+  template<>
+  size_t Bezier4q::Type::size(const char* This) const {
+    return ((Bezier4q*)This)->size();
+  }
+
   /********************** Line4i **************************/
 
   template<>
@@ -97,6 +110,17 @@ namespace embree
     return ((Triangle4i*)This)->size();
   }
 
+  /********************** TriangleMeshlet **************************/
+
+  TriangleMeshlet::Type::Type () 
+    : PrimitiveType("trianglemeshlet",sizeof(TriangleMeshlet),TriangleMeshlet::maxTriangles) {} 
+
+  size_t TriangleMeshlet::Type::size(const char* This) const {
+    return ((TriangleMeshlet*)This)->size();
+  }
+
+  TriangleMeshlet::Type TriangleMeshlet::type;
+
   /********************** Triangle4vMB **************************/
 
   template<>
@@ -0,0 +1,199 @@
+// ======================================================================== //
+// Copyright 2009-2017 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "primitive.h"
+
+namespace embree
+{
+  /* Stores up to 8 triangles of one triangle mesh that share a local
+   * vertex table. Each triangle references its vertices through 8 bit
+   * indices into this table, thus vertices shared between the triangles
+   * of a leaf are stored only once. The triangles are intersected in
+   * groups of 4. */
+  struct TriangleMeshlet
+  {
+    /* Virtual interface to query information about the triangle type */
+    struct Type : public PrimitiveType
+    {
+      Type();
+      size_t size(const char* This) const;
+    };
+    static Type type;
+
+    static const size_t maxTriangles = 8;
+    static const size_t maxVertices = 12;
+    static const size_t numGroups = maxTriangles/4;
+
+  public:
+
+    /* Returns maximal number of stored triangles */
+    static __forceinline size_t max_size() { return maxTriangles; }
+
+    /* Returns number of triangles that fit into a meshlet in any case */
+    static __forceinline size_t min_size() { return maxVertices/3; }
+
+    /* Returns required number of primitive blocks for N primitives, assuming that most vertices are shared */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+    /* Returns the exact number of primitive blocks required to store the primitives of the range */
+    static __forceinline size_t blocks(const PrimRef* prims, size_t begin, size_t end, Scene* scene)
+    {
+      size_t items = 0;
+      while (begin<end) {
+        begin += fits(prims,begin,end,scene);
+        items++;
+      }
+      return items;
+    }
+
+  public:
+
+    /* Returns if the specified triangle is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<maxTriangles); return primIDs[i] != -1; }
+
+    /* Returns the number of stored triangles */
+    __forceinline size_t size() const
+    {
+      size_t n = 0;
+      while (n<maxTriangles && valid(n)) n++;
+      return n;
+    }
+
+    /* Returns the geometry IDs of a group of 4 triangles */
+    __forceinline vint4 geomID4(const size_t g) const { assert(g<numGroups); return vint4(geomID_); }
+    __forceinline int geomID(const size_t i) const { return geomID_; }
+
+    /* Returns the primitive IDs of a group of 4 triangles */
+    __forceinline vint4 primID4(const size_t g) const { assert(g<numGroups); return vint4::loadu(&primIDs[4*g]); }
+    __forceinline int primID(const size_t i) const { assert(i<maxTriangles); return primIDs[i]; }
+
+    /* Returns if the specified group of 4 triangles contains any triangle */
+    __forceinline bool validGroup(const size_t g) const { return valid(4*g); }
+
+    /* Returns a pointer to the vertex of the mesh referenced by a local index */
+    __forceinline const float* vertexPtr(const TriangleMesh* mesh, const unsigned char i) const {
+      return (const float*) mesh->vertexPtr(vertices[i]);
+    }
+
+    /* gather the specified triangle */
+    __forceinline void gather(const size_t i, Vec3f& p0, Vec3f& p1, Vec3f& p2, const Scene* const scene) const
+    {
+      const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID_);
+      p0 = *(const Vec3f*) vertexPtr(mesh,v0[i]);
+      p1 = *(const Vec3f*) vertexPtr(mesh,v1[i]);
+      p2 = *(const Vec3f*) vertexPtr(mesh,v2[i]);
+    }
+
+    /* gather a group of 4 triangles */
+    __forceinline void gather(const size_t g, Vec3vf4& p0, Vec3vf4& p1, Vec3vf4& p2, const Scene* const scene) const
+    {
+      assert(g<numGroups);
+      const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID_);
+      const unsigned char* i0 = &v0[4*g];
+      const unsigned char* i1 = &v1[4*g];
+      const unsigned char* i2 = &v2[4*g];
+      const vfloat4 a0 = vfloat4::loadu(vertexPtr(mesh,i0[0])), a1 = vfloat4::loadu(vertexPtr(mesh,i0[1])), a2 = vfloat4::loadu(vertexPtr(mesh,i0[2])), a3 = vfloat4::loadu(vertexPtr(mesh,i0[3]));
+      const vfloat4 b0 = vfloat4::loadu(vertexPtr(mesh,i1[0])), b1 = vfloat4::loadu(vertexPtr(mesh,i1[1])), b2 = vfloat4::loadu(vertexPtr(mesh,i1[2])), b3 = vfloat4::loadu(vertexPtr(mesh,i1[3]));
+      const vfloat4 c0 = vfloat4::loadu(vertexPtr(mesh,i2[0])), c1 = vfloat4::loadu(vertexPtr(mesh,i2[1])), c2 = vfloat4::loadu(vertexPtr(mesh,i2[2])), c3 = vfloat4::loadu(vertexPtr(mesh,i2[3]));
+      transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z);
+      transpose(b0,b1,b2,b3,p1.x,p1.y,p1.z);
+      transpose(c0,c1,c2,c3,p2.x,p2.y,p2.z);
+    }
+
+  private:
+
+    /* Returns the local index of the vertex, or maxVertices if it is not in the table */
+    static __forceinline size_t find(const unsigned* table, size_t numVertices, unsigned v)
+    {
+      for (size_t i=0; i<numVertices; i++)
+        if (table[i] == v) return i;
+      return maxVertices;
+    }
+
+    /* Returns the number of triangles starting at begin that fit into one meshlet */
+    static __forceinline size_t fits(const PrimRef* prims, size_t begin, size_t end, Scene* scene)
+    {
+      unsigned table[maxVertices];
+      size_t numVertices = 0;
+      const unsigned geomID = prims[begin].geomID();
+      const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID);
+
+      size_t n = 0;
+      for (; n<maxTriangles && begin+n<end; n++)
+      {
+        const PrimRef& prim = prims[begin+n];
+        if (prim.geomID() != geomID) break;
+        const TriangleMesh::Triangle& tri = mesh->triangle(prim.primID());
+
+        size_t numNew = 0; unsigned add[3];
+        for (size_t j=0; j<3; j++)
+          if (find(table,numVertices,tri.v[j]) == maxVertices && find(add,numNew,tri.v[j]) == maxVertices)
+            add[numNew++] = tri.v[j];
+        if (numVertices+numNew > maxVertices) break;
+        for (size_t j=0; j<numNew; j++) table[numVertices++] = add[j];
+      }
+      assert(n);
+      return n;
+    }
+
+  public:
+
+    /* Fill meshlet from triangle list */
+    __forceinline void fill(const PrimRef* prims, size_t& begin, size_t end, Scene* scene)
+    {
+      const size_t n = fits(prims,begin,end,scene);
+      geomID_ = prims[begin].geomID();
+      const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID_);
+
+      size_t numVertices = 0;
+      for (size_t i=0; i<n; i++)
+      {
+        const PrimRef& prim = prims[begin+i];
+        const TriangleMesh::Triangle& tri = mesh->triangle(prim.primID());
+        unsigned char local[3];
+        for (size_t j=0; j<3; j++)
+        {
+          size_t k = find(vertices,numVertices,tri.v[j]);
+          if (k == maxVertices) {
+            k = numVertices++;
+            vertices[k] = tri.v[j];
+          }
+          local[j] = (unsigned char) k;
+        }
+        v0[i] = local[0]; v1[i] = local[1]; v2[i] = local[2];
+        primIDs[i] = prim.primID();
+      }
+
+      /* empty slots reference a degenerate triangle */
+      for (size_t i=numVertices; i<maxVertices; i++) vertices[i] = vertices[0];
+      for (size_t i=n; i<maxTriangles; i++) {
+        v0[i] = v1[i] = v2[i] = 0;
+        primIDs[i] = -1;
+      }
+      begin += n;
+    }
+
+  public:
+    unsigned geomID_;                     // geometry ID of mesh
+    unsigned vertices[maxVertices];       // local vertex table, stores indices into the vertex buffer
+    unsigned char v0[maxTriangles];       // local index of 1st vertex
+    unsigned char v1[maxTriangles];       // local index of 2nd vertex
+    unsigned char v2[maxTriangles];       // local index of 3rd vertex
+    int primIDs[maxTriangles];            // primitive ID of primitive inside mesh
+  };
+}
@@ -43,7 +43,7 @@ namespace embree
           Ref patch = SharedLazyTessellationCache::lookup(entry,commitCounter,[&] () {
               auto alloc = [&](size_t bytes) { return SharedLazyTessellationCache::malloc(bytes); };
               return Patch::create(alloc,edge,vertices,stride);
-            },true);
+            });
 
           auto curTime = SharedLazyTessellationCache::sharedLazyTessellationCache.getTime(commitCounter);
           const bool allAllocationsValid = SharedLazyTessellationCache::validTime(time,curTime);
@@ -137,6 +137,21 @@ namespace embree
       Vec3<simdf> patchNormal(const SubdivPatch1Base& patch, const simdf& uu, const simdf& vv); 
    
 
+    /* eval undisplaced grid over patch and stich edges when required, the normals are optional */      
+    void evalGridNormals(const SubdivPatch1Base& patch,
+                         const unsigned x0, const unsigned x1,
+                         const unsigned y0, const unsigned y1,
+                         const unsigned swidth, const unsigned sheight,
+                         float *__restrict__ const grid_x,
+                         float *__restrict__ const grid_y,
+                         float *__restrict__ const grid_z,
+                         float *__restrict__ const grid_u,
+                         float *__restrict__ const grid_v,
+                         float *__restrict__ const grid_Ng_x,
+                         float *__restrict__ const grid_Ng_y,
+                         float *__restrict__ const grid_Ng_z,
+                         const SubdivMesh* const geom);
+
     /* eval grid over patch and stich edges when required */      
     void evalGrid(const SubdivPatch1Base& patch,
                   const unsigned x0, const unsigned x1,
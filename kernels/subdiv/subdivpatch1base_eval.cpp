@@ -74,17 +74,41 @@ namespace embree
       return Vec3<simdf>( zero );
     }
 
-    /* eval grid over patch and stich edges when required */      
-    void evalGrid(const SubdivPatch1Base& patch,
-                  const unsigned x0, const unsigned x1,
-                  const unsigned y0, const unsigned y1,
-                  const unsigned swidth, const unsigned sheight,
-                  float *__restrict__ const grid_x,
-                  float *__restrict__ const grid_y,
-                  float *__restrict__ const grid_z,
-                  float *__restrict__ const grid_u,
-                  float *__restrict__ const grid_v,
-                  const SubdivMesh* const geom)
+    /* calls the displacement function of the mesh for N points of the patch */
+    static void displaceGrid(const SubdivPatch1Base& patch, const SubdivMesh* const geom,
+                             const float* u, const float* v, const float* nx, const float* ny, const float* nz,
+                             float* px, float* py, float* pz, const unsigned N)
+    {
+      if (geom->displFunc)
+        geom->displFunc(geom->userPtr,patch.geom,patch.prim,u,v,nx,ny,nz,px,py,pz,N);
+      else if (geom->displFunc2)
+        geom->displFunc2(geom->userPtr,patch.geom,patch.prim,patch.time(),u,v,nx,ny,nz,px,py,pz,N);
+      else
+      {
+        dynamic_large_stack_array(unsigned,primIDs,N,64*64*sizeof(unsigned));
+        dynamic_large_stack_array(unsigned,times,N,64*64*sizeof(unsigned));
+        for (unsigned i=0; i<N; i++) {
+          primIDs[i] = patch.prim;
+          times[i] = patch.time();
+        }
+        geom->displFuncN(geom->userPtr,patch.geom,primIDs,times,u,v,nx,ny,nz,px,py,pz,N);
+      }
+    }
+
+    /* eval undisplaced grid over patch and stich edges when required */      
+    void evalGridNormals(const SubdivPatch1Base& patch,
+                         const unsigned x0, const unsigned x1,
+                         const unsigned y0, const unsigned y1,
+                         const unsigned swidth, const unsigned sheight,
+                         float *__restrict__ const grid_x,
+                         float *__restrict__ const grid_y,
+                         float *__restrict__ const grid_z,
+                         float *__restrict__ const grid_u,
+                         float *__restrict__ const grid_v,
+                         float *__restrict__ const grid_Ng_x,
+                         float *__restrict__ const grid_Ng_y,
+                         float *__restrict__ const grid_Ng_z,
+                         const SubdivMesh* const geom)
     {
       const unsigned dwidth  = x1-x0+1;
       const unsigned dheight = y1-y0+1;
@@ -93,19 +117,13 @@ namespace embree
 
       if (unlikely(patch.type == SubdivPatch1Base::EVAL_PATCH))
       {
-        const bool displ = geom->displFunc || geom->displFunc2;
-        const unsigned N = displ ? M : 0;
-        dynamic_large_stack_array(float,grid_Ng_x,N,64*64*sizeof(float));
-        dynamic_large_stack_array(float,grid_Ng_y,N,64*64*sizeof(float));
-        dynamic_large_stack_array(float,grid_Ng_z,N,64*64*sizeof(float));
-        
         if (geom->patch_eval_trees.size())
         {
           feature_adaptive_eval_grid<PatchEvalGrid> 
             (geom->patch_eval_trees[geom->numTimeSteps*patch.prim+patch.time()], patch.subPatch(), patch.needsStitching() ? patch.level : nullptr,
              x0,x1,y0,y1,swidth,sheight,
              grid_x,grid_y,grid_z,grid_u,grid_v,
-             displ ? (float*)grid_Ng_x : nullptr, displ ? (float*)grid_Ng_y : nullptr, displ ? (float*)grid_Ng_z : nullptr,
+             grid_Ng_x,grid_Ng_y,grid_Ng_z,
              dwidth,dheight);
         }
         else 
@@ -116,7 +134,7 @@ namespace embree
             (ccpatch, patch.subPatch(), patch.needsStitching() ? patch.level : nullptr,
             x0,x1,y0,y1,swidth,sheight,
             grid_x,grid_y,grid_z,grid_u,grid_v,
-            displ ? (float*)grid_Ng_x : nullptr, displ ? (float*)grid_Ng_y : nullptr, displ ? (float*)grid_Ng_z : nullptr,
+            grid_Ng_x,grid_Ng_y,grid_Ng_z,
             dwidth,dheight);
         }
 
@@ -135,12 +153,6 @@ namespace embree
           vfloatx::store(&grid_v[i*VSIZEX],patch_v);
         }
 
-        /* call displacement shader */
-        if (unlikely(geom->displFunc))
-          geom->displFunc(geom->userPtr,patch.geom,patch.prim,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
-        else if (unlikely(geom->displFunc2))
-          geom->displFunc2(geom->userPtr,patch.geom,patch.prim,patch.time(),grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
-
         /* set last elements in u,v array to 1.0f */
         const float last_u = grid_u[dwidth*dheight-1];
         const float last_v = grid_v[dwidth*dheight-1];
@@ -178,32 +190,64 @@ namespace embree
         {
           const vfloatx u = vfloatx::load(&grid_u[i*VSIZEX]);
           const vfloatx v = vfloatx::load(&grid_v[i*VSIZEX]);
-          Vec3<vfloatx> vtx = patchEval(patch,u,v);
-        
-          /* evaluate displacement function */
-          if (unlikely(geom->displFunc != nullptr))
-          {
-            const Vec3<vfloatx> normal = normalize_safe(patchNormal(patch, u, v));
-            geom->displFunc(geom->userPtr,patch.geom,patch.prim,
-                            &u[0],&v[0],&normal.x[0],&normal.y[0],&normal.z[0],
-                            &vtx.x[0],&vtx.y[0],&vtx.z[0],VSIZEX);
-          
-          } 
-          else if (unlikely(geom->displFunc2 != nullptr))
-          {
-            const Vec3<vfloatx> normal = normalize_safe(patchNormal(patch, u, v));
-            geom->displFunc2(geom->userPtr,patch.geom,patch.prim,patch.time(),
-                             &u[0],&v[0],&normal.x[0],&normal.y[0],&normal.z[0],
-                             &vtx.x[0],&vtx.y[0],&vtx.z[0],VSIZEX);
-          }
-
+          const Vec3<vfloatx> vtx = patchEval(patch,u,v);
           vfloatx::store(&grid_x[i*VSIZEX],vtx.x);
           vfloatx::store(&grid_y[i*VSIZEX],vtx.y);
           vfloatx::store(&grid_z[i*VSIZEX],vtx.z);
+
+          /* normals are only required for displacement */
+          if (grid_Ng_x)
+          {
+            const Vec3<vfloatx> normal = normalize_safe(patchNormal(patch,u,v));
+            vfloatx::store(&grid_Ng_x[i*VSIZEX],normal.x);
+            vfloatx::store(&grid_Ng_y[i*VSIZEX],normal.y);
+            vfloatx::store(&grid_Ng_z[i*VSIZEX],normal.z);
+          }
         }
       }
     }
 
+    /* eval grid over patch and stich edges when required */      
+    void evalGrid(const SubdivPatch1Base& patch,
+                  const unsigned x0, const unsigned x1,
+                  const unsigned y0, const unsigned y1,
+                  const unsigned swidth, const unsigned sheight,
+                  float *__restrict__ const grid_x,
+                  float *__restrict__ const grid_y,
+                  float *__restrict__ const grid_z,
+                  float *__restrict__ const grid_u,
+                  float *__restrict__ const grid_v,
+                  const SubdivMesh* const geom)
+    {
+      if (likely(!geom->isDisplaced())) {
+        evalGridNormals(patch,x0,x1,y0,y1,swidth,sheight,grid_x,grid_y,grid_z,grid_u,grid_v,nullptr,nullptr,nullptr,geom);
+        return;
+      }
+
+      const unsigned dwidth  = x1-x0+1;
+      const unsigned dheight = y1-y0+1;
+      const unsigned M = dwidth*dheight+VSIZEX;
+      const unsigned grid_size_simd_blocks = (M-1)/VSIZEX;
+      dynamic_large_stack_array(float,grid_Ng_x,M,64*64*sizeof(float));
+      dynamic_large_stack_array(float,grid_Ng_y,M,64*64*sizeof(float));
+      dynamic_large_stack_array(float,grid_Ng_z,M,64*64*sizeof(float));
+      evalGridNormals(patch,x0,x1,y0,y1,swidth,sheight,grid_x,grid_y,grid_z,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,geom);
+
+      /* call displacement shader once for the entire grid */
+      displaceGrid(patch,geom,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
+
+      /* set last elements in x,y,z array to last displaced point */
+      const float last_x = grid_x[dwidth*dheight-1];
+      const float last_y = grid_y[dwidth*dheight-1];
+      const float last_z = grid_z[dwidth*dheight-1];
+      for (unsigned i=dwidth*dheight;i<grid_size_simd_blocks*VSIZEX;i++)
+      {
+        grid_x[i] = last_x;
+        grid_y[i] = last_y;
+        grid_z[i] = last_z;
+      }
+    }
+
 
     /* eval grid over patch and stich edges when required */      
     BBox3fa evalGridBounds(const SubdivPatch1Base& patch,
@@ -222,7 +266,7 @@ namespace embree
 
       if (unlikely(patch.type == SubdivPatch1Base::EVAL_PATCH))
       {
-        const bool displ = geom->displFunc || geom->displFunc2;
+        const bool displ = geom->isDisplaced();
         dynamic_large_stack_array(float,grid_x,M,64*64*sizeof(float));
         dynamic_large_stack_array(float,grid_y,M,64*64*sizeof(float));
         dynamic_large_stack_array(float,grid_z,M,64*64*sizeof(float));
@@ -252,10 +296,8 @@ namespace embree
         }
 
         /* call displacement shader */
-        if (unlikely(geom->displFunc))
-          geom->displFunc(geom->userPtr,patch.geom,patch.prim,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
-        else if (unlikely(geom->displFunc2))
-          geom->displFunc2(geom->userPtr,patch.geom,patch.prim,patch.time(),grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
+        if (unlikely(displ))
+          displaceGrid(patch,geom,grid_u,grid_v,grid_Ng_x,grid_Ng_y,grid_Ng_z,grid_x,grid_y,grid_z,dwidth*dheight);
 
         /* set last elements in u,v array to 1.0f */
         const float last_u = grid_u[dwidth*dheight-1];
@@ -337,20 +379,11 @@ namespace embree
           Vec3<vfloatx> vtx = patchEval(patch,u,v);
         
           /* evaluate displacement function */
-          if (unlikely(geom->displFunc != nullptr))
-          {
-            const Vec3<vfloatx> normal = normalize_safe(patchNormal(patch,u,v));
-            geom->displFunc(geom->userPtr,patch.geom,patch.prim,
-                            &u[0],&v[0],&normal.x[0],&normal.y[0],&normal.z[0],
-                            &vtx.x[0],&vtx.y[0],&vtx.z[0],VSIZEX);
-          
-          }
-          else if (unlikely(geom->displFunc2 != nullptr))
+          if (unlikely(geom->isDisplaced()))
           {
             const Vec3<vfloatx> normal = normalize_safe(patchNormal(patch,u,v));
-            geom->displFunc2(geom->userPtr,patch.geom,patch.prim,patch.time(),
-                            &u[0],&v[0],&normal.x[0],&normal.y[0],&normal.z[0],
-                            &vtx.x[0],&vtx.y[0],&vtx.z[0],VSIZEX);
+            displaceGrid(patch,geom,&u[0],&v[0],&normal.x[0],&normal.y[0],&normal.z[0],
+                         &vtx.x[0],&vtx.y[0],&vtx.z[0],VSIZEX);
           }
 
           bounds_min[0] = min(bounds_min[0],vtx.x);
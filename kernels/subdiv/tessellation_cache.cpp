@@ -42,14 +42,11 @@ namespace embree
     size = 0;
     data = nullptr;
     maxBlocks              = size/BLOCK_SIZE;
+    segmentBlocks          = maxBlocks/NUM_CACHE_SEGMENTS;
     localTime              = NUM_CACHE_SEGMENTS;
-    next_block             = 0;
+    next_block             = segmentBegin(localTime);
     numRenderThreads       = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
+    numFlushes             = 0;
     threadWorkState     = new ThreadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
 
     //reset_state.reset();
@@ -93,47 +90,42 @@ namespace embree
      }
    }
 
+  void SharedLazyTessellationCache::waitForUsersBefore(ThreadWorkState *const t_state,
+                                                       const size_t time)
+  {
+    while (t_state->counter.load() != 0 && t_state->epoch.load() < time)
+    {
+      _mm_pause();
+      _mm_pause();
+      _mm_pause();
+      _mm_pause();
+    }
+  }
+
   void SharedLazyTessellationCache::allocNextSegment() 
   {
     if (reset_state.try_lock())
     {
-      if (next_block >= switch_block_threshold)
+      const size_t time = localTime.load();
+      if (next_block >= segmentBegin(time) + segmentBlocks)
       {
         /* lock the linked list of thread states */
-        
         linkedlist_mtx.lock();
         
-        /* block all threads */
+        /* The next segment still holds the entries of time-(NUM_CACHE_SEGMENTS-1),
+           which are already invalid at the current time. Thus only threads that
+           locked before the current time can still reference that segment and
+           all other threads continue rendering without getting blocked. */
         for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-            waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
-        
+          waitForUsersBefore(t,time);
+
         /* switch to the next segment */
+        next_block = segmentBegin(time+1);
         addCurrentIndex();
-        CACHE_STATS(PRINT("RESET TESS CACHE"));
-        
-#if FORCE_SIMPLE_FLUSH == 1
-        next_block = 0;
-        switch_block_threshold = maxBlocks;
-#else
-        const size_t region = localTime % NUM_CACHE_SEGMENTS;
-        next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-        switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-        assert( switch_block_threshold <= maxBlocks );
-#endif
-        
-        CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
-        
-        /* release all blocked threads */
-        
-        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
+        numFlushes++;
         
         /* unlock the linked list of thread states */
-        
         linkedlist_mtx.unlock();
-	
-        
       }
       reset_state.unlock();
     }
@@ -155,16 +147,13 @@ namespace embree
       if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
         waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
 
-    /* reset to the first segment */
-    next_block = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
-
-    /* reset local time */
+    /* reset local time and thread epochs */
     localTime = NUM_CACHE_SEGMENTS;
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      t->epoch = 0;
+
+    /* reset to the first segment */
+    next_block = segmentBegin(localTime);
 
     /* release all blocked threads */
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
@@ -196,20 +185,13 @@ namespace embree
     data      = nullptr;
     if (size) data = (float*)os_malloc(size); // FIXME: do os_reserve under linux
     maxBlocks = size/BLOCK_SIZE;    
+    segmentBlocks = maxBlocks/NUM_CACHE_SEGMENTS;
 
     /* invalidate entire cache */
     localTime += NUM_CACHE_SEGMENTS; 
 
-    /* reset to the first segment */
-#if FORCE_SIMPLE_FLUSH == 1
-    next_block = 0;
-    switch_block_threshold = maxBlocks;
-#else
-    const size_t region = localTime % NUM_CACHE_SEGMENTS;
-    next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-    switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-    assert( switch_block_threshold <= maxBlocks );
-#endif
+    /* reset to the first block of the current segment */
+    next_block = segmentBegin(localTime);
 
     /* release all blocked threads */
     for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
@@ -227,30 +209,109 @@ namespace embree
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-  std::atomic<size_t> SharedTessellationCacheStats::cache_accesses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_hits(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_misses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_flushes(0);  
-  SpinLock   SharedTessellationCacheStats::mtx;  
-  size_t SharedTessellationCacheStats::cache_num_patches(0);
+  size_t SharedLazyTessellationCache::getNumHits()
+  {
+    size_t hits = 0;
+    linkedlist_mtx.lock();
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      hits += t->hits.load(std::memory_order_relaxed);
+    linkedlist_mtx.unlock();
+    return hits;
+  }
 
-  void SharedTessellationCacheStats::printStats()
+  size_t SharedLazyTessellationCache::getNumMisses()
   {
-    PRINT(cache_accesses);
-    PRINT(cache_misses);
-    PRINT(cache_hits);
-    PRINT(cache_flushes);
-    PRINT(100.0f * cache_hits / cache_accesses);
-    assert(cache_hits + cache_misses == cache_accesses);
-    PRINT(cache_num_patches);
+    size_t misses = 0;
+    linkedlist_mtx.lock();
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      misses += t->misses.load(std::memory_order_relaxed);
+    linkedlist_mtx.unlock();
+    return misses;
   }
 
-  void SharedTessellationCacheStats::clearStats()
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  SharedGridCache SharedGridCache::sharedGridCache;
+
+  void resizeGridCache(size_t new_size, const std::string& filename) {
+    SharedGridCache::sharedGridCache.realloc(new_size,filename);
+  }
+
+  SharedGridCache::SharedGridCache()
+    : data(nullptr), size(0), mapped(false), head(0), pruneHead(0) {}
+
+  SharedGridCache::~SharedGridCache() {
+    free();
+  }
+
+  void SharedGridCache::free()
+  {
+    if (mapped) os_unmap_file(data,size);
+    else if (data) os_free(data,size);
+    data = nullptr;
+    size = 0;
+    mapped = false;
+  }
+
+  void SharedGridCache::realloc(size_t bytes, const std::string& filename)
+  {
+    Lock<SpinLock> lock(mutex);
+    free();
+    index.clear();
+    head = pruneHead = 0;
+    if (bytes == 0) return;
+    
+    if (filename != "") { data = (char*) os_map_file(filename.c_str(),bytes); mapped = true; }
+    else                  data = (char*) os_malloc(bytes);
+    size = bytes;
+  }
+
+  size_t SharedGridCache::newMeshID() 
+  {
+    static std::atomic<size_t> nextMeshID(1);
+    return nextMeshID++;
+  }
+
+  bool SharedGridCache::lookup(const Key& key, void* dst, size_t bytes)
   {
-    SharedTessellationCacheStats::cache_accesses  = 0;
-    SharedTessellationCacheStats::cache_hits      = 0;
-    SharedTessellationCacheStats::cache_misses    = 0;
-    SharedTessellationCacheStats::cache_flushes   = 0;
+    Lock<SpinLock> lock(mutex);
+    auto i = index.find(key);
+    if (i == index.end()) return false;
+    
+    const Location loc = i->second;
+    if (!valid(loc) || loc.bytes != bytes) {
+      index.erase(i);
+      return false;
+    }
+    memcpy(dst,data + loc.pos % size,bytes);
+    return true;
+  }
+
+  void SharedGridCache::insert(const Key& key, const void* src, size_t bytes)
+  {
+    /* large grids would evict too many others */
+    if (bytes > size/4) return;
+
+    Lock<SpinLock> lock(mutex);
+
+    /* grids do not wrap around the end of the ring buffer */
+    size_t pos = (head + 15) & ~size_t(15);
+    if (pos % size + bytes > size) pos += size - pos % size;
+    head = pos + bytes;
+    memcpy(data + pos % size,src,bytes);
+    index[key] = Location(pos,bytes);
+
+    /* remove overwritten grids from the index once per round through the ring buffer */
+    if (head >= pruneHead + size) 
+    {
+      for (auto i=index.begin(); i!=index.end(); ) {
+        if (valid(i->second)) i++;
+        else i = index.erase(i);
+      }
+      pruneHead = head;
+    }
   }
 
   struct cache_regression_test : public RegressionTest
@@ -332,7 +393,9 @@ namespace embree
 
 extern "C" void printTessCacheStats()
 {
+  embree::SharedLazyTessellationCache& cache = embree::SharedLazyTessellationCache::sharedLazyTessellationCache;
   PRINT("SHARED TESSELLATION CACHE");
-  embree::SharedTessellationCacheStats::printStats();
-  embree::SharedTessellationCacheStats::clearStats();
+  PRINT(cache.getNumHits());
+  PRINT(cache.getNumMisses());
+  PRINT(cache.getNumFlushes());
 }
@@ -17,36 +17,12 @@
 #pragma once
 
 #include "../common/default.h"
-
-/* force a complete cache invalidation when running out of allocation space */
-#define FORCE_SIMPLE_FLUSH 0
+#include <unordered_map>
 
 #define THREAD_BLOCK_ATOMIC_ADD 4
 
-#if defined(DEBUG)
-#define CACHE_STATS(x) 
-#else
-#define CACHE_STATS(x) 
-#endif
-
 namespace embree
 {
-  class SharedTessellationCacheStats
-  {
-  public:
-    /* stats */
-    static std::atomic<size_t> cache_accesses;
-    static std::atomic<size_t> cache_hits;
-    static std::atomic<size_t> cache_misses;
-    static std::atomic<size_t> cache_flushes;                
-    static size_t        cache_num_patches;
-    __aligned(64) static SpinLock mtx;
-    
-    /* print stats for debugging */                 
-    static void printStats();
-    static void clearStats();
-  };
-  
   void resizeTessellationCache(size_t new_size);
   void resetTessellationCache();
   
@@ -59,14 +35,22 @@ namespace embree
    ALIGNED_STRUCT;
 
    std::atomic<size_t> counter;
+   std::atomic<size_t> epoch;  //!< cache time when the thread acquired its outermost lock
+   std::atomic<size_t> hits;   //!< number of lookups served from the cache
+   std::atomic<size_t> misses; //!< number of lookups that had to construct the entry
    ThreadWorkState* next;
    bool allocated;
 
    __forceinline ThreadWorkState(bool allocated = false) 
-     : counter(0), next(nullptr), allocated(allocated) 
+     : counter(0), epoch(0), hits(0), misses(0), next(nullptr), allocated(allocated) 
    {
      assert( ((size_t)this % 64) == 0 ); 
    }   
+
+   /* counters are only written by the owning thread, thus no atomic add is required */
+   static __forceinline void increment(std::atomic<size_t>& c) {
+     c.store(c.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
+   }
  };
 
  class __aligned(64) SharedLazyTessellationCache 
@@ -143,14 +127,15 @@ namespace embree
    float *data;
    size_t size;
    size_t maxBlocks;
+   size_t segmentBlocks;
    ThreadWorkState *threadWorkState;
       
    __aligned(64) std::atomic<size_t> localTime;
    __aligned(64) std::atomic<size_t> next_block;
    __aligned(64) SpinLock   reset_state;
    __aligned(64) SpinLock   linkedlist_mtx;
-   __aligned(64) std::atomic<size_t> switch_block_threshold;
    __aligned(64) std::atomic<size_t> numRenderThreads;
+   __aligned(64) std::atomic<size_t> numFlushes;
 
 
  public:
@@ -162,7 +147,12 @@ namespace embree
    void getNextRenderThreadWorkState();
 
    __forceinline size_t maxAllocSize() const {
-     return switch_block_threshold;
+     return segmentBlocks;
+   }
+
+   /* first block of the segment that gets filled at some cache time */
+   __forceinline size_t segmentBegin(const size_t time) const {
+     return (time % NUM_CACHE_SEGMENTS) * segmentBlocks;
    }
 
    __forceinline size_t getCurrentIndex() { return localTime.load(); }
@@ -173,7 +163,14 @@ namespace embree
    }
 
 
-   __forceinline size_t lockThread  (ThreadWorkState *const t_state, const ssize_t plus=1) { return t_state->counter.fetch_add(plus);  }
+   /* the outermost lock of a thread records the epoch the thread may reference cache entries from */
+   __forceinline size_t lockThread  (ThreadWorkState *const t_state, const ssize_t plus=1) 
+   { 
+     const size_t lock = t_state->counter.fetch_add(plus);  
+     if (plus == 1 && lock == 0) t_state->epoch.store(localTime.load());
+     return lock;
+   }
+
    __forceinline size_t unlockThread(ThreadWorkState *const t_state, const ssize_t plus=-1) { assert(isLocked(t_state)); return t_state->counter.fetch_add(plus); }
 
    __forceinline bool isLocked(ThreadWorkState *const t_state) { return t_state->counter.load() != 0; }
@@ -208,7 +205,6 @@ namespace embree
    static __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
    {   
      const int64_t subdiv_patch_root_ref = entry.tag.get(); 
-     CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
      
      if (likely(subdiv_patch_root_ref != 0)) 
      {
@@ -216,17 +212,13 @@ namespace embree
        const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
        
        if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
-       {
-         CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
          return (void*) subdiv_patch_root;
-       }
      }
-     CACHE_STATS(SharedTessellationCacheStats::cache_misses++);
      return nullptr;
    }
 
    template<typename Constructor>
-     static __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor, const bool before=false) -> decltype(constructor())
+     static __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor) -> decltype(constructor())
    {
      ThreadWorkState *t_state = SharedLazyTessellationCache::threadState();
 
@@ -234,18 +226,22 @@ namespace embree
      {
        sharedLazyTessellationCache.lockThreadLoop(t_state);
        void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
-       if (patch) return (decltype(constructor())) patch;
+       if (patch) {
+         ThreadWorkState::increment(t_state->hits);
+         return (decltype(constructor())) patch;
+       }
        
        if (entry.mutex.try_lock())
        {
          if (!validTag(entry.tag,globalTime)) 
          {
-           auto timeBefore = sharedLazyTessellationCache.getTime(globalTime);
+           ThreadWorkState::increment(t_state->misses);
+           /* tag with the time before construction, as the data may not
+              live in a segment older than that time */
+           auto time = sharedLazyTessellationCache.getTime(globalTime);
            auto ret = constructor(); // thread is locked here!
            assert(ret);
            /* this should never return nullptr */
-           auto timeAfter = sharedLazyTessellationCache.getTime(globalTime);
-           auto time = before ? timeBefore : timeAfter;
            __memory_barrier();
            entry.tag = SharedLazyTessellationCache::Tag(ret,time);
            __memory_barrier();
@@ -258,18 +254,18 @@ namespace embree
      }
    }
    
+   /* Entries stay valid for NUM_CACHE_SEGMENTS-2 segment switches. The
+      segment reused by the next switch is thus already invalid for all
+      threads that locked at the current time, and a switch only has to
+      wait for threads that locked before. */
    __forceinline bool validCacheIndex(const size_t i, const size_t globalTime)
    {
-#if FORCE_SIMPLE_FLUSH == 1
-     return i == getTime(globalTime);
-#else
-     return i+(NUM_CACHE_SEGMENTS-1) >= getTime(globalTime);
-#endif
+     return i+(NUM_CACHE_SEGMENTS-2) >= getTime(globalTime);
    }
 
    static __forceinline bool validTime(const size_t oldtime, const size_t newTime)
    {
-     return oldtime+(NUM_CACHE_SEGMENTS-1) >= newTime;
+     return oldtime+(NUM_CACHE_SEGMENTS-2) >= newTime;
    }
 
 
@@ -283,15 +279,20 @@ namespace embree
 
    void waitForUsersLessEqual(ThreadWorkState *const t_state,
 			      const unsigned int users);
+
+   void waitForUsersBefore(ThreadWorkState *const t_state,
+                           const size_t time);
     
+   /* the allocation has to lie inside the segment of the time read
+      before, otherwise it raced with a segment switch and has to retry */
    __forceinline size_t alloc(const size_t blocks)
    {
-     if (unlikely(blocks >= switch_block_threshold))
+     if (unlikely(blocks >= segmentBlocks))
        throw_RTCError(RTC_INVALID_OPERATION,"allocation exceeds size of tessellation cache segment");
 
-     assert(blocks < switch_block_threshold);
-     size_t index = next_block.fetch_add(blocks);
-     if (unlikely(index + blocks >= switch_block_threshold)) return (size_t)-1;
+     const size_t begin = segmentBegin(localTime.load());
+     const size_t index = next_block.fetch_add(blocks);
+     if (unlikely(index < begin || index + blocks >= begin + segmentBlocks)) return (size_t)-1;
      return index;
    }
 
@@ -332,6 +333,108 @@ namespace embree
 
    void reset();
 
+   /* statistics accumulated over all render threads */
+   size_t getNumHits();
+   size_t getNumMisses();
+   size_t getNumFlushes() { return numFlushes.load(); }
+
    static SharedLazyTessellationCache sharedLazyTessellationCache;
  };
+
+ /*! Second level cache for evaluated vertex grids of displaced
+     subdivision patches. The grids are stored in a ring buffer that
+     lives either in memory or in a mapped file, and thus survive
+     segment switches of the shared tessellation cache. */
+ class SharedGridCache
+ {
+ public:
+
+   struct Key
+   {
+     __forceinline Key () {}
+
+     __forceinline Key (size_t meshID, unsigned primID, size_t commitCounter, unsigned timeSteps,
+                        const unsigned short u[4], const unsigned short v[4], const float level[4])
+     {
+       data[0] = meshID;
+       data[1] = (size_t(primID) << 32) | timeSteps;
+       data[2] = commitCounter;
+       data[3] = (size_t(u[0]) << 48) | (size_t(u[1]) << 32) | (size_t(u[2]) << 16) | size_t(u[3]);
+       data[4] = (size_t(v[0]) << 48) | (size_t(v[1]) << 32) | (size_t(v[2]) << 16) | size_t(v[3]);
+       data[5] = (size_t(unsigned(level[0])) << 32) | size_t(unsigned(level[1]));
+       data[6] = (size_t(unsigned(level[2])) << 32) | size_t(unsigned(level[3]));
+     }
+
+     __forceinline bool operator== (const Key& other) const {
+       for (size_t i=0; i<N; i++) if (data[i] != other.data[i]) return false;
+       return true;
+     }
+
+     __forceinline size_t hash() const 
+     {
+       size_t h = 0;
+       for (size_t i=0; i<N; i++) h = (h ^ data[i]) * size_t(0x100000001b3);
+       return h;
+     }
+
+     struct Hasher {
+       __forceinline size_t operator() (const Key& key) const { return key.hash(); }
+     };
+
+   private:
+     static const size_t N = 7;
+     uint64_t data[N];
+   };
+
+ public:
+   SharedGridCache();
+   ~SharedGridCache();
+
+   /*! reallocates the cache, an empty filename keeps the grids in memory */
+   void realloc(size_t bytes, const std::string& filename);
+
+   /*! cache has to get enabled through realloc before rendering */
+   __forceinline bool enabled() const { return size != 0; }
+
+   /*! copies the grid data of the key to dst, returns false if not present */
+   bool lookup(const Key& key, void* dst, size_t bytes);
+
+   /*! stores the grid data of the key, evicting the oldest grids */
+   void insert(const Key& key, const void* src, size_t bytes);
+
+   /*! returns a process wide unique ID used to identify meshes in keys */
+   static size_t newMeshID();
+
+ private:
+
+   struct Location 
+   {
+     __forceinline Location () {}
+     __forceinline Location (size_t pos, size_t bytes) : pos(pos), bytes(bytes) {}
+
+     size_t pos;   //!< position in the ring buffer, not wrapped around
+     size_t bytes; //!< number of bytes stored
+   };
+
+   /* data gets overwritten once the head moves more than size bytes past it */
+   __forceinline bool valid(const Location& loc) const {
+     return loc.pos + size >= head;
+   }
+
+   void free();
+
+ private:
+   char* data;
+   size_t size;
+   bool mapped;
+   size_t head;
+   size_t pruneHead;
+   std::unordered_map<Key,Location,Key::Hasher> index;
+   SpinLock mutex;
+
+ public:
+   static SharedGridCache sharedGridCache;
+ };
+
+ void resizeGridCache(size_t new_size, const std::string& filename);
 }
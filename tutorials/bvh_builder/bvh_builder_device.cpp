@@ -139,6 +139,28 @@ namespace embree
       std::cout << 1000.0f*(t1-t0) << "ms, " << 1E-6*double(prims.size())/(t1-t0) << " Mprims/s, sah = " << sah << " [DONE]" << std::endl;
     }
 
+    /* move all primitives and refit the BVH of the last build */
+    for (size_t j=0; j<prims.size(); j++) {
+      prims[j].lower_x += 1.0f; prims[j].upper_x += 1.0f;
+    }
+    std::cout << "refitting BVH over " << prims.size() << " primitives, " << std::flush;
+    double t0 = getSeconds();
+    rtcRefitBVH(bvh,prims.data(),InnerNode::setBounds,nullptr);
+    double t1 = getSeconds();
+    std::cout << 1000.0f*(t1-t0) << "ms, " << 1E-6*double(prims.size())/(t1-t0) << " Mprims/s [DONE]" << std::endl;
+
+    /* build a BVH4 directly into a compact node array */
+    settings.maxBranchingFactor = 4;
+    settings.maxLeafSize = 4;
+    for (size_t j=0; j<prims.size(); j++) prims[j] = prims_i[j];
+    std::cout << "building compact BVH4 over " << prims.size() << " primitives, " << std::flush;
+    t0 = getSeconds();
+    size_t numNodes = 0;
+    const RTCCompactNode* nodes = rtcBuildBVHCompact(bvh,settings,prims.data(),prims.size(),splitPrimitive,buildProgress,nullptr,&numNodes);
+    t1 = getSeconds();
+    std::cout << 1000.0f*(t1-t0) << "ms, " << 1E-6*double(prims.size())/(t1-t0) << " Mprims/s, " << numNodes << " nodes [DONE]" << std::endl;
+    assert(numNodes == 0 || nodes[0].count != 0);
+
     rtcMakeStaticBVH(bvh);
     rtcDeleteBVH(bvh);
   }
@@ -1472,6 +1472,40 @@ namespace embree
     }
   };
 
+  bool cancelCommitFunction(void* ptr, double n) 
+  {
+    rtcCancelCommit((RTCScene)ptr);
+    return true;
+  }
+
+  struct CancelCommitTest : public VerifyApplication::Test
+  {
+    CancelCommitTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      VerifyScene scene(device,RTC_SCENE_STATIC,aflags);
+      scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(zero,1.0f,200));
+      AssertNoError(device);
+
+      /* cancel commit from inside the build */
+      rtcSetProgressMonitorFunction(scene,cancelCommitFunction,(RTCScene)scene);
+      rtcCommit (scene);
+      AssertError(device,RTC_CANCELLED);
+
+      /* next commit has to succeed */
+      rtcSetProgressMonitorFunction(scene,nullptr,nullptr);
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct GarbageGeometryTest : public VerifyApplication::Test
   {
     GarbageGeometryTest (std::string name, int isa)
@@ -1644,6 +1678,40 @@ namespace embree
       return passed;
     }
     
+    bool checkInterpolationN(const RTCSceneRef& scene, int geomID, RTCBufferType buffer, size_t N)
+    {
+      /* rtcInterpolateN has to match rtcInterpolate for coherent and incoherent query points */
+      bool passed = true;
+      const size_t numUVs = 64;
+      std::vector<int> valid(numUVs+8);
+      std::vector<unsigned> primIDs(numUVs+8);
+      std::vector<float> us(numUVs+8), vs(numUVs+8);
+      avector<float> P(N*numUVs), dPdu(N*numUVs), dPdv(N*numUVs);
+      for (size_t coherent=0; coherent<2; coherent++)
+      {
+        for (size_t i=0; i<numUVs+8; i++) {
+          valid[i] = i%7 == 3 ? 0 : -1;
+          primIDs[i] = coherent ? unsigned(i/16)%num_interpolation_quad_faces : unsigned(random_int())%num_interpolation_quad_faces;
+          us[i] = random_float();
+          vs[i] = random_float();
+        }
+        rtcInterpolateN(scene,geomID,valid.data(),primIDs.data(),us.data(),vs.data(),numUVs,buffer,P.data(),dPdu.data(),dPdv.data(),N);
+        
+        for (size_t i=0; i<numUVs; i++)
+        {
+          if (!valid[i]) continue;
+          float P1[256], dPdu1[256], dPdv1[256];
+          rtcInterpolate(scene,geomID,primIDs[i],us[i],vs[i],buffer,P1,dPdu1,dPdv1,N);
+          for (size_t j=0; j<N; j++) {
+            passed &= fabsf(P1[j]-P[j*numUVs+i]) < 1E-4f;
+            passed &= fabsf(dPdu1[j]-dPdu[j*numUVs+i]) < 1E-3f;
+            passed &= fabsf(dPdv1[j]-dPdv[j*numUVs+i]) < 1E-3f;
+          }
+        }
+      }
+      return passed;
+    }
+    
     bool checkSubdivInterpolation(const RTCDeviceRef& device, const RTCSceneRef& scene, int geomID, RTCBufferType buffer, float* vertices0, size_t N, size_t N_total)
     {
       rtcSetBoundaryMode(scene,geomID,RTC_BOUNDARY_SMOOTH);
@@ -1664,6 +1732,7 @@ namespace embree
       
       passed &= checkInterpolationSharpVertex(scene,geomID,6,0.0f,1.0f,12,buffer,vertices0,N,N_total);
       passed &= checkInterpolationSharpVertex(scene,geomID,8,1.0f,1.0f,15,buffer,vertices0,N,N_total);
+      passed &= checkInterpolationN(scene,geomID,buffer,N);
       
       rtcSetSubdivisionMode(scene,geomID,0,RTC_SUBDIV_PIN_CORNERS);
       AssertNoError(device);
@@ -2077,6 +2146,70 @@ namespace embree
     }
   };
   
+  struct RoundLineHitTest : public VerifyApplication::IntersectTest
+  {
+    RTCSceneFlags sflags; 
+    size_t numTimeSteps;
+
+    RoundLineHitTest (std::string name, int isa, RTCSceneFlags sflags, size_t numTimeSteps, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), numTimeSteps(numTimeSteps) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* round line of radius 0.5 from x=0 to x=4, moving by 1 along y in the second time step */
+      const float r = 0.5f;
+      Vec3fa vertices0[2] = { Vec3fa(0.0f,0.0f,0.0f,r), Vec3fa(4.0f,0.0f,0.0f,r) };
+      Vec3fa vertices1[2] = { Vec3fa(0.0f,1.0f,0.0f,r), Vec3fa(4.0f,1.0f,0.0f,r) };
+      int indices[1] = { 0 };
+      RTCSceneRef scene = rtcDeviceNewScene(device,sflags,to_aflags(imode));
+      int geomID = rtcNewRoundLineSegments (scene, RTC_GEOMETRY_STATIC, 1, 2, numTimeSteps);
+      rtcSetBuffer(scene, geomID, RTC_VERTEX_BUFFER0, vertices0, 0, sizeof(Vec3fa));
+      if (numTimeSteps == 2) rtcSetBuffer(scene, geomID, RTC_VERTEX_BUFFER1, vertices1, 0, sizeof(Vec3fa));
+      rtcSetBuffer(scene, geomID, RTC_INDEX_BUFFER , indices, 0, sizeof(int));
+      rtcCommit (scene);
+      AssertNoError(device);
+
+      /* shoot rays down and up onto the cylinder body and the spherical caps */
+      const float time = numTimeSteps == 2 ? 0.5f : 0.0f;
+      float x[256], z[256];
+      RTCRay rays[256];
+      for (size_t i=0; i<256; i++)
+      {
+        x[i] = 4.8f*random_float()-0.4f;
+        z[i] = 0.6f*random_float()-0.3f;
+        const float dx = x[i] - clamp(x[i],0.0f,4.0f);
+        if (dx*dx+z[i]*z[i] > 0.9f*r*r) { x[i] = 2.0f; z[i] = 0.0f; } // avoid grazing hits 
+        const float sy = i%2 ? -1.0f : 1.0f;
+        rays[i] = makeRay(Vec3fa(x[i],4.0f*sy,z[i]),Vec3fa(0.0f,-sy,0.0f));
+        rays[i].time = time;
+      }
+      IntersectWithMode(imode,ivariant,scene,rays,256);
+
+      for (size_t i=0; i<256; i++)
+      {
+        if (rays[i].geomID != 0) return VerifyApplication::FAILED;
+        if (ivariant & VARIANT_OCCLUDED) continue;
+        if (rays[i].primID != 0) return VerifyApplication::FAILED;
+        const float dx = x[i] - clamp(x[i],0.0f,4.0f);
+        const float sy = i%2 ? -1.0f : 1.0f;
+        const float y = sy*sqrt(r*r-dx*dx-z[i]*z[i]);
+        if (abs(rays[i].tfar - (4.0f-sy*(time+y))) > 1E-4f) return VerifyApplication::FAILED;
+        if (abs(rays[i].u - clamp(x[i]/4.0f,0.0f,1.0f)) > 1E-4f) return VerifyApplication::FAILED;
+        const Vec3fa Ng = normalize(Vec3fa(rays[i].Ng[0],rays[i].Ng[1],rays[i].Ng[2]));
+        if (reduce_max(abs(Ng - Vec3fa(dx,y,z[i])/r)) > 1E-3f) return VerifyApplication::FAILED;
+      }
+      AssertNoError(device);
+      
+      return VerifyApplication::PASSED;
+    }
+  };
+  
   struct RayMasksTest : public VerifyApplication::IntersectTest
   {
     RTCSceneFlags sflags; 
@@ -2449,6 +2582,20 @@ namespace embree
       if      (model == "sphere.triangles") scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTriangleSphere(pos,2.0f,size));
       else if (model == "sphere.quads"    ) scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createQuadSphere    (pos,2.0f,size));
       else if (model == "sphere.subdiv"   ) scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere  (pos,2.0f,4,64));
+      else if (model == "sphere.subdiv_view") 
+      {
+        /* camera close to the sphere produces strongly varying and culled edge levels */
+        unsigned geomID = scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivSphere(pos,2.0f,4,64));
+        RTCTessellationView view;
+        view.camera_x = pos.x+2.5f; view.camera_y = pos.y; view.camera_z = pos.z;
+        view.dir_x = -1.0f; view.dir_y = 0.0f; view.dir_z = 0.0f;
+        view.fovy = 60.0f;
+        view.aspect = 1.0f;
+        view.height = 512;
+        view.pixelsPerEdge = 8.0f;
+        view.culledLevel = 1.0f;
+        rtcSetTessellationView(scene,geomID,&view);
+      }
       else if (model == "plane.triangles" ) scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createTrianglePlane (Vec3fa(pos.x,-6.0f,-6.0f),Vec3fa(0.0f,0.0f,12.0f),Vec3fa(0.0f,12.0f,0.0f),size,size));
       else if (model == "plane.quads"     ) scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createQuadPlane     (Vec3fa(pos.x,-6.0f,-6.0f),Vec3fa(0.0f,0.0f,12.0f),Vec3fa(0.0f,12.0f,0.0f),size,size));
       else if (model == "plane.subdiv"    ) scene.addGeometry(RTC_GEOMETRY_STATIC,SceneGraph::createSubdivPlane   (Vec3fa(pos.x,-6.0f,-6.0f),Vec3fa(0.0f,0.0f,12.0f),Vec3fa(0.0f,12.0f,0.0f),size,size,2));
@@ -3860,6 +4007,60 @@ namespace embree
     }
   };
 
+  struct UpdateSubdivTopologyBenchmark : public VerifyApplication::Benchmark
+  {
+    size_t numPhi;
+    size_t numDirtyFaces;
+    RTCDeviceRef device;
+    Ref<VerifyScene> scene;
+    Ref<SceneGraph::SubdivMeshNode> mesh;
+    unsigned geomID;
+
+    UpdateSubdivTopologyBenchmark (std::string name, int isa, size_t numPhi, size_t numDirtyFaces)
+      : VerifyApplication::Benchmark(name,isa,"Mfaces/s",true,10), numPhi(numPhi), numDirtyFaces(numDirtyFaces), 
+        device(nullptr), scene(nullptr), mesh(nullptr), geomID(RTC_INVALID_GEOMETRY_ID) {}
+
+    bool setup(VerifyApplication* state) 
+    {
+      std::string cfg = "start_threads=1,set_affinity=1,isa="+stringOfISA(isa) + ",threads=" + std::to_string((long long)numThreads)+","+state->rtcore;
+      device = rtcNewDevice(cfg.c_str());
+      errorHandler(rtcDeviceGetError(device));
+      rtcDeviceSetErrorFunction(device,errorHandler);
+
+      scene = new VerifyScene(device,RTC_SCENE_DYNAMIC,aflags_all);
+      mesh = SceneGraph::createSubdivPlane(zero,Vec3fa(1,0,0),Vec3fa(0,1,0),numPhi,numPhi,1.0f).dynamicCast<SceneGraph::SubdivMeshNode>();
+      geomID = scene->addGeometry(RTC_GEOMETRY_DYNAMIC,mesh.dynamicCast<SceneGraph::Node>());
+      rtcCommit (*scene);
+      AssertNoError(device);
+      return true;
+    }
+
+    float benchmark(VerifyApplication* state)
+    {
+      /* rotating the vertex indices of a face changes its half edges but not the surface */
+      const size_t numFaces = mesh->verticesPerFace.size();
+      for (size_t i=0; i<numDirtyFaces; i++) {
+        unsigned* face = &mesh->position_indices[4*(i*numFaces/numDirtyFaces)];
+        std::rotate(face,face+1,face+4);
+      }
+
+      double t0 = getSeconds();
+      rtcUpdateBuffer(*scene,geomID,RTC_INDEX_BUFFER);
+      rtcCommit (*scene);
+      AssertNoError(device);
+      double t1 = getSeconds();
+
+      return 1E-6f*float(numFaces)/float(t1-t0);
+    }
+      
+    virtual void cleanup(VerifyApplication* state) 
+    {
+      scene = nullptr;
+      mesh = nullptr;
+      device = nullptr;
+    }
+  };
+
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
@@ -4048,6 +4249,7 @@ namespace embree
       groups.pop();
 
       groups.top()->add(new GarbageGeometryTest("build_garbage_geom",isa));
+      groups.top()->add(new CancelCommitTest("cancel_commit",isa));
 
       GeometryType gtypes_memory[] = { TRIANGLE_MESH, TRIANGLE_MESH_MB, QUAD_MESH, QUAD_MESH_MB, HAIR_GEOMETRY, HAIR_GEOMETRY_MB, LINE_GEOMETRY, LINE_GEOMETRY_MB };
       std::vector<std::pair<RTCSceneFlags,RTCGeometryFlags>> sflags_gflags_memory;
@@ -4108,6 +4310,15 @@ namespace embree
                 groups.top()->add(new QuadHitTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_GEOMETRY_STATIC,imode,ivariant));
       groups.pop();
 
+      push(new TestGroup("round_line_hit",true,true));
+      for (auto sflags : sceneFlags) 
+        for (auto imode : intersectModes) 
+          for (auto ivariant : intersectVariants)
+            if (has_variant(imode,ivariant))
+              for (size_t numTimeSteps=1; numTimeSteps<=2; numTimeSteps++)
+                groups.top()->add(new RoundLineHitTest(to_string(sflags,imode,ivariant)+"_"+std::to_string((long long)numTimeSteps),isa,sflags,numTimeSteps,imode,ivariant));
+      groups.pop();
+
       if (rtcDeviceGetParameter1i(device,RTC_CONFIG_RAY_MASK)) 
       {
         push(new TestGroup("ray_masks",true,true));
@@ -4198,7 +4409,7 @@ namespace embree
       }
 
       push(new TestGroup("watertight_subdiv",true,true)); {
-        std::string watertightModels [] = { "sphere.subdiv", "plane.subdiv"};
+        std::string watertightModels [] = { "sphere.subdiv", "sphere.subdiv_view", "plane.subdiv"};
         const Vec3fa watertight_pos = Vec3fa(148376.0f,1234.0f,-223423.0f);
         for (auto sflags : sceneFlagsRobust) 
           for (auto imode : intersectModes) 
@@ -4358,6 +4569,9 @@ namespace embree
             groups.top()->add(new CreateGeometryBenchmark("update."+to_string(gtype)+"_"+std::get<0>(num_prims)+"."+to_string(sflags.first,sflags.second),
                                                           isa,gtype,sflags.first,sflags.second,std::get<1>(num_prims),std::get<2>(num_prims),true,true));
 
+      for (size_t numDirtyFaces : { 1, 100, 10000, 262144 })
+        groups.top()->add(new UpdateSubdivTopologyBenchmark("update_topology.subdiv_256k.dirty_"+std::to_string((long long)numDirtyFaces),isa,512,numDirtyFaces));
+
       groups.pop(); // benchmarks
 
       /**************************************************************************/